@@ -0,0 +1,69 @@
+/**
+ * @file	bench\AllocationCounter.cpp.
+ *
+ * @brief	Counts the heap allocations of a benchmark executable by replacing the global operator new.
+ */
+#include "Harness.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<long long> allocations(0);
+
+	void *allocate(std::size_t size)
+	{
+		allocations.fetch_add(1, std::memory_order_relaxed);
+
+		void *memory = std::malloc(size ? size : 1);
+
+		if (!memory)
+		{
+			throw std::bad_alloc();
+		}
+
+		return memory;
+	}
+}
+
+namespace etunn
+{
+	namespace bench
+	{
+		long long allocationCount()
+		{
+			return allocations.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+void *operator new(std::size_t size)
+{
+	return allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+	return allocate(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
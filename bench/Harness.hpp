@@ -0,0 +1,277 @@
+/**
+ * @file	bench\Harness.hpp.
+ *
+ * @brief	Declares the helpers shared by the benchmark executables.
+ */
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace etunn
+{
+	namespace bench
+	{
+		/**
+		 * @fn	long long allocationCount();
+		 *
+		 * @brief	Gets the number of heap allocations made by the process so far.
+		 *
+		 * @return	The number of allocations.
+		 */
+		long long allocationCount();
+
+		/**
+		 * @fn	double elapsedSeconds(std::chrono::steady_clock::time_point start)
+		 *
+		 * @brief	Gets the seconds passed since a point in time.
+		 */
+		inline double elapsedSeconds(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		/**
+		 * @fn	template<typename T> inline void doNotOptimize(const T &value)
+		 *
+		 * @brief	Keeps the compiler from removing the computation of a value.
+		 */
+		template<typename T>
+		inline void doNotOptimize(const T &value)
+		{
+#if defined(__GNUC__)
+			asm volatile("" : : "r,m"(value) : "memory");
+#else
+			static volatile const T *sink;
+			sink = &value;
+#endif
+		}
+
+		/**
+		 * @struct	Result
+		 *
+		 * @brief	A named set of measurements.
+		 */
+		struct Result
+		{
+			/** @brief	The name of the benchmark. */
+			std::string name;
+
+			/** @brief	The measurements, in the order they are reported. */
+			std::vector<std::pair<std::string, double> > values;
+
+			/**
+			 * @fn	Result(const std::string &name)
+			 *
+			 * @brief	Constructor.
+			 */
+			Result(const std::string &name) : name(name) {}
+
+			/**
+			 * @fn	Result& add(const std::string &key, double value)
+			 *
+			 * @brief	Adds a measurement.
+			 *
+			 * @return	This object.
+			 */
+			Result& add(const std::string &key, double value)
+			{
+				values.push_back(std::make_pair(key, value));
+				return *this;
+			}
+		};
+
+		/**
+		 * @class	Runner
+		 *
+		 * @brief	Parses the common command line options, times benchmarks and reports the results.
+		 * 			Options: --filter &lt;text&gt; (only run benchmarks whose name contains the text),
+		 * 			--min-time &lt;seconds&gt; (minimum measuring time per benchmark, default 0.2),
+		 * 			--json &lt;file&gt; (also write the results as JSON).
+		 */
+		class Runner
+		{
+		public:
+
+			/**
+			 * @fn	Runner(int argc, char **argv)
+			 *
+			 * @brief	Constructor.
+			 */
+			Runner(int argc, char **argv) : minTime(0.2)
+			{
+				for (int i = 1; i + 1 < argc; i += 2)
+				{
+					std::string option = argv[i];
+
+					if (option == "--filter")
+					{
+						filter = argv[i + 1];
+					}
+					else if (option == "--min-time")
+					{
+						minTime = std::atof(argv[i + 1]);
+					}
+					else if (option == "--json")
+					{
+						jsonPath = argv[i + 1];
+					}
+				}
+			}
+
+			/**
+			 * @fn	bool selected(const std::string &name) const
+			 *
+			 * @brief	Checks whether a benchmark passes the filter.
+			 */
+			bool selected(const std::string &name) const
+			{
+				return filter.empty() || name.find(filter) != std::string::npos;
+			}
+
+			/**
+			 * @fn	double getMinTime() const
+			 *
+			 * @brief	Gets the minimum measuring time per benchmark in seconds.
+			 */
+			double getMinTime() const
+			{
+				return minTime;
+			}
+
+			/**
+			 * @fn	template<typename F> void measure(const std::string &name, double itemsPerOp, F op, const Result &params)
+			 *
+			 * @brief	Runs op in growing batches until minTime is reached and reports
+			 * 			ns/op, allocations/op, ops/s and items/s.
+			 *
+			 * @param	name	  	The name of the benchmark.
+			 * @param	itemsPerOp	Amount of work per call (e.g. weights or genomes) for the throughput.
+			 * @param	op		  	The operation.
+			 * @param	params	  	Parameters reported along with the measurements.
+			 */
+			template<typename F>
+			void measure(const std::string &name, double itemsPerOp, F op, const Result &params)
+			{
+				if (!selected(name))
+				{
+					return;
+				}
+
+				//Warm up
+				op();
+
+				long long iterations = 1;
+				double seconds = 0;
+				long long allocations = 0;
+
+				while (true)
+				{
+					long long allocationsBefore = allocationCount();
+					std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+					for (long long i = 0; i < iterations; ++i)
+					{
+						op();
+					}
+
+					seconds = elapsedSeconds(start);
+					allocations = allocationCount() - allocationsBefore;
+
+					if (seconds >= minTime || iterations >= (1LL << 40))
+					{
+						break;
+					}
+
+					iterations *= seconds > 0 ? std::min(10.0, 1.5 * minTime / seconds) + 1 : 10;
+				}
+
+				Result result(name);
+				result.values = params.values;
+				result.add("iterations", (double)iterations)
+					.add("ns_per_op", seconds * 1e9 / iterations)
+					.add("allocs_per_op", (double)allocations / iterations)
+					.add("ops_per_sec", iterations / seconds)
+					.add("items_per_sec", itemsPerOp * iterations / seconds);
+
+				report(result);
+			}
+
+			/**
+			 * @fn	void report(const Result &result)
+			 *
+			 * @brief	Prints a result and keeps it for the JSON output.
+			 */
+			void report(const Result &result)
+			{
+				std::printf("%-40s", result.name.c_str());
+
+				for (int i = 0; i < result.values.size(); ++i)
+				{
+					std::printf(" %s=%.6g", result.values[i].first.c_str(), result.values[i].second);
+				}
+
+				std::printf("\n");
+				std::fflush(stdout);
+
+				results.push_back(result);
+			}
+
+			/**
+			 * @fn	int finish() const
+			 *
+			 * @brief	Writes the JSON output if requested.
+			 *
+			 * @return	The exit code of the benchmark.
+			 */
+			int finish() const
+			{
+				if (jsonPath.empty())
+				{
+					return 0;
+				}
+
+				std::FILE *file = std::fopen(jsonPath.c_str(), "w");
+
+				if (!file)
+				{
+					std::fprintf(stderr, "Could not open %s\n", jsonPath.c_str());
+					return 1;
+				}
+
+				std::fprintf(file, "{\n  \"results\": [");
+
+				for (int r = 0; r < results.size(); ++r)
+				{
+					std::fprintf(file, "%s\n    {\"name\": \"%s\"", r ? "," : "", results[r].name.c_str());
+
+					for (int i = 0; i < results[r].values.size(); ++i)
+					{
+						std::fprintf(file, ", \"%s\": %.17g", results[r].values[i].first.c_str(), results[r].values[i].second);
+					}
+
+					std::fprintf(file, "}");
+				}
+
+				std::fprintf(file, "\n  ]\n}\n");
+				std::fclose(file);
+
+				return 0;
+			}
+
+		private:
+			std::string filter;
+			std::string jsonPath;
+			double minTime;
+			std::vector<Result> results;
+		};
+	}
+}
+
+#endif
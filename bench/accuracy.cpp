@@ -0,0 +1,234 @@
+/**
+ * @file	bench\accuracy.cpp.
+ *
+ * @brief	Measures the error and the speed of the accuracy tiers of the sigmoid curve and tanh.
+ * 			Exits with 1 if a tier misses its documented accuracy.
+ */
+#include "Harness.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../include/FastMath.hpp"
+
+using namespace etunn;
+
+namespace
+{
+	/**
+	 * @struct	Function
+	 *
+	 * @brief	A function with its approximations and an exact reference.
+	 */
+	struct Function
+	{
+		std::string name;
+		double (*scalar)(MathAccuracy accuracy, double x);
+		void (*array)(MathAccuracy accuracy, const double *inputs, double *outputs, int count);
+		long double (*reference)(long double x);
+	};
+
+	double sigmoidScalar(MathAccuracy accuracy, double x)
+	{
+		return fastmath::sigmoid(accuracy, x);
+	}
+
+	void sigmoidArray(MathAccuracy accuracy, const double *inputs, double *outputs, int count)
+	{
+		fastmath::sigmoid(accuracy, inputs, outputs, count, 1);
+	}
+
+	long double sigmoidReference(long double x)
+	{
+		return 1 / (1 + std::exp(-x));
+	}
+
+	double tanhScalar(MathAccuracy accuracy, double x)
+	{
+		return fastmath::tanh(accuracy, x);
+	}
+
+	void tanhArray(MathAccuracy accuracy, const double *inputs, double *outputs, int count)
+	{
+		fastmath::tanh(accuracy, inputs, outputs, count);
+	}
+
+	long double tanhReference(long double x)
+	{
+		return std::tanh(x);
+	}
+
+	/**
+	 * @fn	double difference(double a, double b)
+	 *
+	 * @brief	The absolute difference of two results. Two NaNs agree; NaN against a number counts
+	 * 			as the worst possible error.
+	 */
+	double difference(double a, double b)
+	{
+		if (a != a || b != b)
+		{
+			return (a != a) == (b != b) ? 0 : 1;
+		}
+
+		return std::fabs(a - b);
+	}
+
+	/**
+	 * @fn	double tolerance(MathAccuracy accuracy)
+	 *
+	 * @brief	The largest absolute error a tier may have.
+	 */
+	double tolerance(MathAccuracy accuracy)
+	{
+		switch (accuracy)
+		{
+		case MathAccuracy::Polynomial:
+			return 2e-6;
+		case MathAccuracy::Table:
+			return 1e-3;
+		default:
+			return 1e-12;
+		}
+	}
+
+	/**
+	 * @fn	bool measureAccuracy(bench::Runner &runner, const Function &function, MathAccuracy accuracy)
+	 *
+	 * @brief	Compares a tier against the reference on a fine grid over [-20, 20] and a few
+	 * 			arguments far outside (including infinities and NaN), and the vectorized version
+	 * 			against the scalar one.
+	 *
+	 * @return	False if the tier or its vectorized version misses the tolerance.
+	 */
+	bool measureAccuracy(bench::Runner &runner, const Function &function, MathAccuracy accuracy)
+	{
+		std::string name = "accuracy/" + function.name + "/" + mathAccuracyName(accuracy);
+
+		if (!runner.selected(name))
+		{
+			return true;
+		}
+
+		std::vector<double> inputs;
+
+		for (int i = -2000000; i <= 2000000; ++i)
+		{
+			inputs.push_back(i * 1e-5);
+		}
+
+		const double extremes[] = { -1e300, -800, -710, -40, 40, 710, 800, 1e300,
+			-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+			std::numeric_limits<double>::quiet_NaN() };
+		inputs.insert(inputs.end(), extremes, extremes + sizeof(extremes) / sizeof(extremes[0]));
+
+		std::vector<double> outputs(inputs.size());
+		function.array(accuracy, inputs.data(), outputs.data(), inputs.size());
+
+		double maxError = 0, sumError = 0, worstInput = 0, maxDifference = 0;
+
+		for (int i = 0; i < inputs.size(); ++i)
+		{
+			double value = function.scalar(accuracy, inputs[i]);
+			double error = difference(value, (double)function.reference(inputs[i]));
+
+			if (error > maxError)
+			{
+				maxError = error;
+				worstInput = inputs[i];
+			}
+
+			sumError += error;
+			maxDifference = std::max(maxDifference, difference(value, outputs[i]));
+		}
+
+		//The vectorized version must agree with the scalar one as well
+		bool passed = maxError <= tolerance(accuracy) && maxDifference <= tolerance(accuracy);
+
+		runner.report(bench::Result(name)
+			.add("max_abs_error", maxError)
+			.add("mean_abs_error", sumError / inputs.size())
+			.add("worst_input", worstInput)
+			.add("array_max_difference", maxDifference)
+			.add("tolerance", tolerance(accuracy))
+			.add("passed", passed));
+
+		return passed;
+	}
+
+	/**
+	 * @fn	void measureSpeed(bench::Runner &runner, const Function &function, MathAccuracy accuracy)
+	 *
+	 * @brief	Measures the scalar and the vectorized version of a tier on typical net inputs.
+	 */
+	void measureSpeed(bench::Runner &runner, const Function &function, MathAccuracy accuracy)
+	{
+		const int count = 1024;
+		std::vector<double> inputs, outputs(count);
+
+		for (int i = 0; i < count; ++i)
+		{
+			inputs.push_back(((rand()) / (RAND_MAX + 1.0) - 0.5) * 12);
+		}
+
+		bench::Result params("");
+		params.add("values", count);
+
+		std::string prefix = function.name + "/" + mathAccuracyName(accuracy);
+
+		runner.measure(prefix + "/scalar", count, [&]()
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				outputs[i] = function.scalar(accuracy, inputs[i]);
+			}
+
+			bench::doNotOptimize(outputs);
+		}, params);
+
+		runner.measure(prefix + "/array", count, [&]()
+		{
+			function.array(accuracy, inputs.data(), outputs.data(), count);
+			bench::doNotOptimize(outputs);
+		}, params);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	bench::Runner runner(argc, argv);
+
+	Function functions[] =
+	{
+		{ "sigmoid", sigmoidScalar, sigmoidArray, sigmoidReference },
+		{ "tanh", tanhScalar, tanhArray, tanhReference }
+	};
+
+	MathAccuracy tiers[] = { MathAccuracy::Exact, MathAccuracy::Polynomial, MathAccuracy::Table };
+	bool passed = true;
+
+	for (int f = 0; f < 2; ++f)
+	{
+		for (int t = 0; t < 3; ++t)
+		{
+			passed = measureAccuracy(runner, functions[f], tiers[t]) && passed;
+		}
+	}
+
+	for (int f = 0; f < 2; ++f)
+	{
+		for (int t = 0; t < 3; ++t)
+		{
+			measureSpeed(runner, functions[f], tiers[t]);
+		}
+	}
+
+	int result = runner.finish();
+
+	return passed ? result : 1;
+}
@@ -0,0 +1,345 @@
+/**
+ * @file	bench\evolve.cpp.
+ *
+ * @brief	End-to-end benchmark evolving networks on synthetic tasks with the genetic algorithm.
+ */
+#include "Harness.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../include/evolutionary/NeuralNet.hpp"
+
+using namespace etunn;
+using namespace etunn::evolutionary;
+
+namespace
+{
+	const double pi = 3.14159265358979323846;
+
+	/**
+	 * @struct	Task
+	 *
+	 * @brief	A fitness task. Fitness is always in [0, 1].
+	 */
+	struct Task
+	{
+		std::string name;
+		int numInputs;
+		std::vector<int> hidden;
+		int numOutputs;
+		double targetFitness;
+		double (*evaluate)(NeuralNet &net, Params p);
+	};
+
+	double evaluateXor(NeuralNet &net, Params p)
+	{
+		static const double cases[4][3] = { { 0, 0, 0 }, { 0, 1, 1 }, { 1, 0, 1 }, { 1, 1, 0 } };
+		double error = 0;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			std::vector<double> inputs(cases[i], cases[i] + 2);
+			error += std::fabs(net.update(inputs, p)[0] - cases[i][2]);
+		}
+
+		return 1 - error / 4;
+	}
+
+	double evaluateSine(NeuralNet &net, Params p)
+	{
+		const int numSamples = 32;
+		double error = 0;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			double x = (double)i / (numSamples - 1);
+			std::vector<double> inputs(1, x);
+
+			//Scaled into the range of the sigmoid
+			error += std::fabs(net.update(inputs, p)[0] - (std::sin(2 * pi * x) + 1) / 2);
+		}
+
+		return 1 - error / numSamples;
+	}
+
+	double evaluateCartPole(NeuralNet &net, Params p)
+	{
+		const int maxSteps = 500;
+		const double gravity = 9.8, massCart = 1.0, massPole = 0.1, halfLength = 0.5, force = 10, tau = 0.02;
+		const double totalMass = massCart + massPole, poleMassLength = massPole * halfLength;
+		static const double starts[4][4] = { { 0, 0, 0.05, 0 }, { 0, 0, -0.05, 0 }, { 0.5, 0, 0.02, 0.1 }, { -0.5, 0, -0.02, -0.1 } };
+
+		int survived = 0;
+
+		for (int s = 0; s < 4; ++s)
+		{
+			double x = starts[s][0], xDot = starts[s][1], theta = starts[s][2], thetaDot = starts[s][3];
+
+			for (int step = 0; step < maxSteps; ++step)
+			{
+				if (std::fabs(x) > 2.4 || std::fabs(theta) > 12 * pi / 180)
+				{
+					break;
+				}
+
+				std::vector<double> inputs;
+				inputs.push_back(x / 2.4);
+				inputs.push_back(xDot / 3);
+				inputs.push_back(theta / 0.21);
+				inputs.push_back(thetaDot / 3);
+
+				double push = net.update(inputs, p)[0] > 0.5 ? force : -force;
+
+				//Euler integration of the cart-pole dynamics
+				double cosTheta = std::cos(theta), sinTheta = std::sin(theta);
+				double temp = (push + poleMassLength * thetaDot * thetaDot * sinTheta) / totalMass;
+				double thetaAcc = (gravity * sinTheta - cosTheta * temp) /
+					(halfLength * (4.0 / 3.0 - massPole * cosTheta * cosTheta / totalMass));
+				double xAcc = temp - poleMassLength * thetaAcc * cosTheta / totalMass;
+
+				x += tau * xDot;
+				xDot += tau * xAcc;
+				theta += tau * thetaDot;
+				thetaDot += tau * thetaAcc;
+
+				++survived;
+			}
+		}
+
+		return (double)survived / (4 * maxSteps);
+	}
+
+	//Solves a task with EvolutionStrategy, each thread evaluating with its own net
+	void runStrategy(bench::Runner &runner, const Task &task, int seed, int popSize, int maxGenerations, int numThreads)
+	{
+		std::string name = "es/" + task.name + "/seed" + std::to_string(seed);
+
+		if (!runner.selected(name))
+		{
+			return;
+		}
+
+		srand(seed);
+
+		NeuralNetConfiguration config;
+		config.numInputs(task.numInputs).hiddenLayerSizes(task.hidden).numOutputs(task.numOutputs);
+
+		Params p;
+		p.setParams(config);
+
+		std::vector<NeuralNet> nets(std::max(1, numThreads), NeuralNet(p));
+
+		for (int i = 0; i < nets.size(); ++i)
+		{
+			nets[i].createNet();
+		}
+
+		EvolutionStrategy es(nets[0].getWeights(), popSize / 2, 0.1, Optimizer(OptimizerType::Adam, 0.05));
+
+		EvolutionStrategy::FitnessFunction fitness = [&](const std::vector<double> &weights, int thread)
+		{
+			std::vector<double> candidate = weights;
+			nets[thread].putWeights(candidate);
+			return task.evaluate(nets[thread], p);
+		};
+
+		int generation = 0;
+		double bestFitness = 0;
+		double timeToTarget = -1;
+		int generationsToTarget = -1;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		for (; generation < maxGenerations; ++generation)
+		{
+			es.epoch(fitness, nets.size());
+			bestFitness = std::max(bestFitness, es.getBestFitness());
+
+			if (bestFitness >= task.targetFitness)
+			{
+				timeToTarget = bench::elapsedSeconds(start);
+				generationsToTarget = generation + 1;
+				++generation;
+				break;
+			}
+		}
+
+		double seconds = bench::elapsedSeconds(start);
+
+		bench::Result result(name);
+		result.add("population", es.getPopulationSize())
+			.add("weights", nets[0].getNumberOfWeights())
+			.add("threads", nets.size())
+			.add("generations", generation)
+			.add("best_fitness", bestFitness)
+			.add("generations_per_sec", generation / seconds)
+			.add("evaluations_per_sec", (double)generation * es.getPopulationSize() / seconds)
+			.add("generations_to_target", generationsToTarget)
+			.add("seconds_to_target", timeToTarget);
+
+		runner.report(result);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	bench::Runner runner(argc, argv);
+
+	int popSize = 100;
+	int maxGenerations = 200;
+	int numSeeds = 3;
+	std::string profilePrefix;
+	bool cache = false;
+	int numThreads = 1;
+	MutationAdaptation adaptation = MutationAdaptation::None;
+	StoppingCriteria stopping;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+
+		if (option == "--population")
+		{
+			popSize = std::atoi(argv[i + 1]);
+		}
+		else if (option == "--generations")
+		{
+			maxGenerations = std::atoi(argv[i + 1]);
+		}
+		else if (option == "--seeds")
+		{
+			numSeeds = std::atoi(argv[i + 1]);
+		}
+		else if (option == "--cache")
+		{
+			cache = std::atoi(argv[i + 1]) != 0;
+		}
+		else if (option == "--adaptation")
+		{
+			std::string name = argv[i + 1];
+			adaptation = name == "fifth" ? MutationAdaptation::OneFifthRule :
+				(name == "self" ? MutationAdaptation::SelfAdaptive : MutationAdaptation::None);
+		}
+		else if (option == "--stagnation")
+		{
+			stopping.stagnationGenerations = std::atoi(argv[i + 1]);
+		}
+		else if (option == "--min-diversity")
+		{
+			stopping.minDiversity = std::atof(argv[i + 1]);
+		}
+		else if (option == "--time-budget")
+		{
+			stopping.maxSeconds = std::atof(argv[i + 1]);
+		}
+		else if (option == "--threads")
+		{
+			numThreads = std::atoi(argv[i + 1]);
+		}
+		else if (option == "--profile")
+		{
+			profilePrefix = argv[i + 1];
+		}
+	}
+
+	std::vector<Task> tasks;
+	tasks.push_back(Task{ "xor", 2, std::vector<int>(1, 4), 1, 0.9, evaluateXor });
+	tasks.push_back(Task{ "sine", 1, std::vector<int>(1, 8), 1, 0.95, evaluateSine });
+	tasks.push_back(Task{ "cartpole", 4, std::vector<int>(1, 8), 1, 1.0, evaluateCartPole });
+
+	for (int t = 0; t < tasks.size(); ++t)
+	{
+		const Task &task = tasks[t];
+
+		for (int seed = 1; seed <= numSeeds; ++seed)
+		{
+			runStrategy(runner, task, seed, popSize, maxGenerations, numThreads);
+
+			std::string name = "evolve/" + task.name + "/seed" + std::to_string(seed);
+
+			if (!runner.selected(name))
+			{
+				continue;
+			}
+
+			srand(seed);
+
+			NeuralNetConfiguration config;
+			config.numInputs(task.numInputs).hiddenLayerSizes(task.hidden).numOutputs(task.numOutputs);
+
+			Params p;
+			p.setParams(config);
+
+			NeuralNet net(p);
+			net.createNet();
+
+			GeneticAlgorithm ga(popSize, p.mutationRate, p.crossoverRate, net.getNumberOfWeights());
+
+			if (!profilePrefix.empty())
+			{
+				ga.enableProfiling(true, bench::allocationCount);
+			}
+
+			ga.enableFitnessCache(cache);
+			ga.setMutationAdaptation(adaptation);
+
+			StoppingCriteria criteria = stopping;
+			criteria.targetFitness = task.targetFitness;
+			criteria.maxGenerations = maxGenerations;
+
+			long long evaluations = 0;
+			std::vector<double> weights;
+
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			StopReason reason = ga.run([&](const std::vector<double> &candidate)
+			{
+				weights = candidate;
+				net.putWeights(weights);
+				evaluations++;
+
+				return task.evaluate(net, p);
+			}, criteria, p);
+
+			double seconds = bench::elapsedSeconds(start);
+			int generation = ga.getGeneration();
+			double bestFitness = ga.getBestGenome().fitness;
+			bool reached = reason == StopReason::TargetReached;
+
+			bench::Result result(name);
+			result.add("population", popSize)
+				.add("weights", net.getNumberOfWeights())
+				.add("generations", generation)
+				.add("best_fitness", bestFitness)
+				.add("generations_per_sec", generation / seconds)
+				.add("evaluations_per_sec", evaluations / seconds)
+				.add("cache_hits", (double)ga.getFitnessCache().getHits())
+				.add("perturbation_scale", ga.getPerturbationScale())
+				.add("diversity", ga.getFitnessStats().diversity)
+				.add("stopped_early", reason == StopReason::Stagnation || reason == StopReason::DiversityCollapse ||
+					reason == StopReason::TimeBudget)
+				.add("generations_to_target", reached ? generation : -1)
+				.add("seconds_to_target", reached ? seconds : -1);
+
+			runner.report(result);
+
+			if (!profilePrefix.empty())
+			{
+				std::string path = profilePrefix + "-" + task.name + "-seed" + std::to_string(seed) + ".csv";
+				std::FILE *file = std::fopen(path.c_str(), "w");
+
+				if (file)
+				{
+					std::fputs(profilesToCSV(ga.getProfiles()).c_str(), file);
+					std::fclose(file);
+				}
+			}
+		}
+	}
+
+	return runner.finish();
+}
@@ -0,0 +1,524 @@
+/**
+ * @file	bench\micro.cpp.
+ *
+ * @brief	Microbenchmarks of the forward pass, the genetic operators and the weight I/O.
+ */
+#include "Harness.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "../include/Dataset.hpp"
+#include "../include/evolutionary/GenomeCodec.hpp"
+#include "../include/evolutionary/IncrementalEvaluator.hpp"
+#include "../include/evolutionary/NeuralNet.hpp"
+#include "../include/evolutionary/PopulationEvaluator.hpp"
+#include "../include/feedforward/NeuralNet.hpp"
+#include "../include/lstm/NeuralNet.hpp"
+#include "../include/Optimizer.hpp"
+
+using namespace etunn;
+using namespace etunn::evolutionary;
+
+namespace
+{
+	struct Shape
+	{
+		int inputs;
+		std::vector<int> hidden;
+		int outputs;
+
+		std::string name() const
+		{
+			std::string text = std::to_string(inputs);
+
+			for (int i = 0; i < hidden.size(); ++i)
+			{
+				text += "-" + std::to_string(hidden[i]);
+			}
+
+			return text + "-" + std::to_string(outputs);
+		}
+	};
+
+	Params configure(const Shape &shape)
+	{
+		NeuralNetConfiguration config;
+		config.numInputs(shape.inputs).hiddenLayerSizes(shape.hidden).numOutputs(shape.outputs);
+
+		Params p;
+		p.setParams(config);
+
+		return p;
+	}
+
+	std::vector<Genome> randomPopulation(int size, int numWeights)
+	{
+		std::vector<Genome> pop;
+
+		for (int i = 0; i < size; ++i)
+		{
+			std::vector<double> weights;
+
+			for (int j = 0; j < numWeights; ++j)
+			{
+				weights.push_back((rand()) / (RAND_MAX + 1.0) - 0.5);
+			}
+
+			pop.push_back(Genome(weights, (rand()) / (RAND_MAX + 1.0)));
+		}
+
+		return pop;
+	}
+
+	//Streams a dataset once through the forward pass
+	void measureDataset(bench::Runner &runner, const std::string &name, const std::string &path, DatasetFormat format,
+		bool prefetch, int numRows, NeuralNet &net, Params p)
+	{
+		DatasetReader reader;
+
+		if (!runner.selected(name) || !reader.open(path, format, p.numInputs, p.numOutputs, 256, prefetch))
+		{
+			return;
+		}
+
+		bench::Result params("");
+		params.add("rows", numRows);
+
+		runner.measure(name, numRows, [&]()
+		{
+			Batch batch;
+			reader.rewind();
+
+			while (reader.next(batch))
+			{
+				for (int i = 0; i < batch.numRows; ++i)
+				{
+					bench::doNotOptimize(net.update(batch.getInputs(i), p));
+				}
+			}
+		}, params);
+	}
+
+	//Runs a sequence through an LSTM step by step and all at once
+	void measureLSTM(bench::Runner &runner, const Shape &shape, int length)
+	{
+		Params p = configure(shape);
+		lstm::NeuralNet net(p);
+		net.createNet();
+
+		std::vector<std::vector<double> > sequence;
+
+		for (int t = 0; t < length; ++t)
+		{
+			sequence.push_back(randomPopulation(1, shape.inputs)[0].weights);
+		}
+
+		bench::Result params("");
+		params.add("weights", net.getNumberOfWeights()).add("steps", length);
+
+		runner.measure("lstmSteps/" + shape.name() + "/" + std::to_string(length), length, [&]()
+		{
+			net.reset();
+
+			for (int t = 0; t < length; ++t)
+			{
+				bench::doNotOptimize(net.update(sequence[t], p));
+			}
+		}, params);
+
+		runner.measure("lstmSequence/" + shape.name() + "/" + std::to_string(length), length, [&]()
+		{
+			net.reset();
+			bench::doNotOptimize(net.processSequence(sequence, p));
+		}, params);
+
+		lstm::State state = net.createState();
+		std::vector<double> outputs(shape.outputs);
+
+		runner.measure("lstmStateSteps/" + shape.name() + "/" + std::to_string(length), length, [&]()
+		{
+			state.reset();
+
+			for (int t = 0; t < length; ++t)
+			{
+				net.step(sequence[t].data(), state, outputs.data(), p);
+			}
+
+			bench::doNotOptimize(outputs);
+		}, params);
+	}
+
+	//Runs each update rule over a flat weight vector and one training step of a feedforward net
+	void measureOptimizers(bench::Runner &runner, const Shape &shape)
+	{
+		const int numWeights = 1 << 20;
+		const int batchSize = 256;
+
+		const OptimizerType types[] = { OptimizerType::SGD, OptimizerType::Momentum, OptimizerType::RMSProp, OptimizerType::Adam };
+		const char *names[] = { "sgd", "momentum", "rmsprop", "adam" };
+
+		std::vector<double> weights = randomPopulation(1, numWeights)[0].weights;
+		std::vector<double> gradients = randomPopulation(1, numWeights)[0].weights;
+
+		Params p = configure(shape);
+		feedforward::NeuralNet net(p);
+		net.createNet();
+
+		//Random rows of inputs and targets
+		std::vector<double> rows = randomPopulation(1, batchSize * (shape.inputs + shape.outputs))[0].weights;
+		Batch batch;
+		batch.data = rows.data();
+		batch.numRows = batchSize;
+		batch.numInputs = shape.inputs;
+		batch.numTargets = shape.outputs;
+
+		bench::Result trainParams("");
+		trainParams.add("weights", net.getNumberOfWeights()).add("rows", batchSize);
+
+		for (int t = 0; t < 4; ++t)
+		{
+			Optimizer optimizer(types[t], 1e-6);
+			optimizer.reset(numWeights);
+
+			bench::Result params("");
+			params.add("weights", numWeights);
+
+			runner.measure(std::string("optimizer/") + names[t], numWeights, [&]()
+			{
+				optimizer.apply(weights, gradients);
+				bench::doNotOptimize(weights);
+			}, params);
+
+			Optimizer trainer(types[t], 0.001);
+			trainer.reset(net.getNumberOfWeights());
+
+			runner.measure("train/" + shape.name() + "/" + names[t], batchSize, [&]()
+			{
+				bench::doNotOptimize(net.train(batch, trainer, p));
+			}, trainParams);
+		}
+	}
+
+	void measureDatasets(bench::Runner &runner)
+	{
+		const int numRows = 20000;
+		const std::string binaryPath = "etunn_bench_dataset.bin", csvPath = "etunn_bench_dataset.csv";
+
+		if (!runner.selected("dataset/binary") && !runner.selected("dataset/binary-prefetch") &&
+			!runner.selected("dataset/csv") && !runner.selected("dataset/csv-prefetch"))
+		{
+			return;
+		}
+
+		Params p = configure(Shape{ 32, std::vector<int>(1, 16), 8 });
+		NeuralNet net(p);
+		net.createNet();
+
+		std::FILE *binary = std::fopen(binaryPath.c_str(), "wb");
+		std::FILE *csv = std::fopen(csvPath.c_str(), "w");
+
+		if (!binary || !csv)
+		{
+			return;
+		}
+
+		for (int r = 0; r < numRows; ++r)
+		{
+			std::vector<double> row = randomPopulation(1, p.numInputs + p.numOutputs)[0].weights;
+			std::fwrite(row.data(), sizeof(double), row.size(), binary);
+
+			for (int c = 0; c < row.size(); ++c)
+			{
+				std::fprintf(csv, c ? ",%.6f" : "%.6f", row[c]);
+			}
+
+			std::fprintf(csv, "\n");
+		}
+
+		std::fclose(binary);
+		std::fclose(csv);
+
+		measureDataset(runner, "dataset/binary", binaryPath, DatasetFormat::Binary, false, numRows, net, p);
+		measureDataset(runner, "dataset/binary-prefetch", binaryPath, DatasetFormat::Binary, true, numRows, net, p);
+		measureDataset(runner, "dataset/csv", csvPath, DatasetFormat::CSV, false, numRows, net, p);
+		measureDataset(runner, "dataset/csv-prefetch", csvPath, DatasetFormat::CSV, true, numRows, net, p);
+
+		std::remove(binaryPath.c_str());
+		std::remove(csvPath.c_str());
+	}
+}
+
+int main(int argc, char **argv)
+{
+	bench::Runner runner(argc, argv);
+
+	std::vector<Shape> shapes;
+	shapes.push_back(Shape{ 8, std::vector<int>(1, 16), 4 });
+	shapes.push_back(Shape{ 32, std::vector<int>(2, 64), 8 });
+	shapes.push_back(Shape{ 128, std::vector<int>(2, 256), 16 });
+
+	std::vector<int> populations;
+	populations.push_back(50);
+	populations.push_back(200);
+	populations.push_back(1000);
+
+	for (int s = 0; s < shapes.size(); ++s)
+	{
+		srand(1);
+
+		const Shape &shape = shapes[s];
+		Params p = configure(shape);
+
+		NeuralNet net(p);
+		net.createNet();
+
+		int numWeights = net.getNumberOfWeights();
+		bench::Result params("");
+		params.add("weights", numWeights);
+
+		std::vector<double> inputs(shape.inputs, 0.5);
+
+		runner.measure("update/" + shape.name(), numWeights, [&]()
+		{
+			std::vector<double> in = inputs;
+			bench::doNotOptimize(net.update(in, p));
+		}, params);
+
+#ifdef ETUNN_INSTRUMENTATION
+		if (runner.selected("update/" + shape.name()))
+		{
+			const LatencyHistogram &latency = net.getInferenceStats().getLatency();
+
+			bench::Result stats("update-latency/" + shape.name());
+			stats.add("calls", (double)latency.getCount())
+				.add("p50_ns", (double)latency.getPercentile(50))
+				.add("p99_ns", (double)latency.getPercentile(99))
+				.add("p999_ns", (double)latency.getPercentile(99.9))
+				.add("max_ns", (double)latency.getMax());
+
+			for (int i = 0; i < net.getInferenceStats().getNumLayers(); ++i)
+			{
+				stats.add("layer" + std::to_string(i) + "_seconds", net.getInferenceStats().getLayerSeconds(i));
+			}
+
+			runner.report(stats);
+		}
+#endif
+
+		Workspace workspace = net.createWorkspace();
+		std::vector<double> outputs(shape.outputs);
+
+		runner.measure("updateWorkspace/" + shape.name(), numWeights, [&]()
+		{
+			net.update(inputs.data(), outputs.data(), workspace, p);
+			bench::doNotOptimize(outputs);
+		}, params);
+
+		//The same net with approximated activations
+		MathAccuracy tiers[] = { MathAccuracy::Polynomial, MathAccuracy::Table };
+		std::vector<double> netWeights = net.getWeights();
+
+		for (int t = 0; t < 2; ++t)
+		{
+			p.mathAccuracy = tiers[t];
+			NeuralNet approximated(p);
+			approximated.createNet();
+			approximated.putWeights(netWeights);
+			p.mathAccuracy = MathAccuracy::Exact;
+
+			runner.measure("updateWorkspace/" + shape.name() + "/" + mathAccuracyName(tiers[t]), numWeights, [&]()
+			{
+				approximated.update(inputs.data(), outputs.data(), workspace, p);
+				bench::doNotOptimize(outputs);
+			}, params);
+		}
+
+		runner.measure("getWeights/" + shape.name(), numWeights, [&]()
+		{
+			bench::doNotOptimize(net.getWeights());
+		}, params);
+
+		std::vector<double> weights = net.getWeights();
+
+		runner.measure("putWeights/" + shape.name(), numWeights, [&]()
+		{
+			net.putWeights(weights);
+		}, params);
+
+		//Fitness set of 32 inputs, child differing from the parent in two weights
+		std::vector<std::vector<double> > samples;
+
+		for (int i = 0; i < 32; ++i)
+		{
+			samples.push_back(randomPopulation(1, shape.inputs)[0].weights);
+		}
+
+		std::vector<double> child = weights;
+		child[rand() % numWeights] += 0.1;
+		child[rand() % numWeights] -= 0.1;
+
+		IncrementalEvaluator incremental(net.getTopology(), samples, p);
+		incremental.setParent(weights);
+		std::vector<std::vector<double> > childOutputs;
+
+		runner.measure("evaluateFull/" + shape.name(), samples.size(), [&]()
+		{
+			for (int i = 0; i < samples.size(); ++i)
+			{
+				std::vector<double> in = samples[i];
+				bench::doNotOptimize(net.update(in, p));
+			}
+		}, params);
+
+		runner.measure("evaluateIncremental/" + shape.name(), samples.size(), [&]()
+		{
+			incremental.evaluate(child, childOutputs);
+			bench::doNotOptimize(childOutputs);
+		}, params);
+
+		for (int i = 0; i < populations.size(); ++i)
+		{
+			int popSize = populations[i];
+			std::vector<Genome> pop = randomPopulation(popSize, numWeights);
+
+			bench::Result popParams = params;
+			popParams.add("population", popSize);
+
+			GeneticAlgorithm ga(popSize, p.mutationRate, p.crossoverRate, numWeights);
+
+			runner.measure("epoch/" + shape.name() + "/" + std::to_string(popSize), popSize, [&]()
+			{
+				bench::doNotOptimize(ga.epoch(pop, p));
+			}, popParams);
+
+			//Time of each phase of the epoch per genome, from the profiles of the genetic algorithm.
+			//The selection, crossover and mutation phases are timed per pair, so they include the clock reads
+			std::string phasesName = "epochPhases/" + shape.name() + "/" + std::to_string(popSize);
+
+			if (runner.selected(phasesName))
+			{
+				GeneticAlgorithm profiled(popSize, p.mutationRate, p.crossoverRate, numWeights);
+				profiled.enableProfiling(true, bench::allocationCount);
+
+				EpochProfile total;
+				double seconds = 0;
+				int epochs = 0;
+
+				while (seconds < runner.getMinTime() || epochs < 2)
+				{
+					bench::doNotOptimize(profiled.epoch(pop, p));
+					++epochs;
+
+					const EpochProfile &profile = profiled.getProfiles().back();
+
+					for (int j = 0; j < numEpochPhases; ++j)
+					{
+						total.seconds[j] += profile.seconds[j];
+						total.allocations[j] += profile.allocations[j];
+						seconds += profile.seconds[j];
+					}
+				}
+
+				bench::Result phases(phasesName);
+				phases.values = popParams.values;
+				phases.add("epochs", epochs);
+
+				for (int j = 0; j < numEpochPhases; ++j)
+				{
+					std::string phase = epochPhaseName((EpochPhase)j);
+					phases.add(phase + "_ns_per_genome", total.seconds[j] * 1e9 / ((double)epochs * popSize))
+						.add(phase + "_allocs_per_genome", (double)total.allocations[j] / ((double)epochs * popSize));
+				}
+
+				runner.report(phases);
+			}
+
+			//Running the population on the fitness set, one net per genome vs. straight from the weights
+			Workspace workspace = net.createWorkspace();
+			std::vector<double> popOutputs(popSize * samples.size() * shape.outputs);
+
+			runner.measure("evaluateNets/" + shape.name() + "/" + std::to_string(popSize), popSize * samples.size(), [&]()
+			{
+				for (int g = 0; g < popSize; ++g)
+				{
+					net.putWeights(pop[g].weights);
+
+					for (int s = 0; s < samples.size(); ++s)
+					{
+						net.update(samples[s].data(), &popOutputs[(g * samples.size() + s) * shape.outputs], workspace, p);
+					}
+				}
+
+				bench::doNotOptimize(popOutputs);
+			}, popParams);
+
+			PopulationEvaluator evaluator(net.getTopology(), samples, p);
+
+			runner.measure("evaluatePopulation/" + shape.name() + "/" + std::to_string(popSize), popSize * samples.size(), [&]()
+			{
+				evaluator.evaluate(pop, popOutputs);
+				bench::doNotOptimize(popOutputs);
+			}, popParams);
+
+			//Interleaved up front as well, so evaluateInterleaved also runs when interleave is filtered out
+			std::vector<double> interleaved;
+			evaluator.interleave(pop, interleaved);
+
+			runner.measure("interleave/" + shape.name() + "/" + std::to_string(popSize), popSize, [&]()
+			{
+				evaluator.interleave(pop, interleaved);
+				bench::doNotOptimize(interleaved);
+			}, popParams);
+
+			runner.measure("evaluateInterleaved/" + shape.name() + "/" + std::to_string(popSize), popSize * samples.size(), [&]()
+			{
+				evaluator.evaluateInterleaved(interleaved.data(), popSize, popOutputs.data());
+				bench::doNotOptimize(popOutputs);
+			}, popParams);
+
+			//Encoding the next generation on its own and as a delta against this one
+			std::vector<Genome> offspring = ga.epoch(pop, p);
+			GenomeCodec codec(WeightPrecision::Float16);
+			std::vector<unsigned char> encoded, delta;
+			std::vector<Genome> decoded;
+
+			codec.encode(offspring, encoded);
+			codec.encode(offspring, pop, delta);
+
+			bench::Result codecParams = popParams;
+			codecParams.add("raw_bytes", (double)popSize * numWeights * sizeof(double))
+				.add("float16_bytes", encoded.size())
+				.add("delta_bytes", delta.size());
+
+			runner.measure("encodePopulation/" + shape.name() + "/" + std::to_string(popSize), popSize, [&]()
+			{
+				codec.encode(offspring, encoded);
+				bench::doNotOptimize(encoded);
+			}, codecParams);
+
+			runner.measure("encodeDelta/" + shape.name() + "/" + std::to_string(popSize), popSize, [&]()
+			{
+				codec.encode(offspring, pop, delta);
+				bench::doNotOptimize(delta);
+			}, codecParams);
+
+			runner.measure("decodeDelta/" + shape.name() + "/" + std::to_string(popSize), popSize, [&]()
+			{
+				GenomeCodec::decode(delta, pop, decoded);
+				bench::doNotOptimize(decoded);
+			}, codecParams);
+		}
+	}
+
+	measureDatasets(runner);
+
+	measureOptimizers(runner, Shape{ 32, std::vector<int>(2, 64), 8 });
+
+	measureLSTM(runner, Shape{ 8, std::vector<int>(1, 32), 4 }, 64);
+	measureLSTM(runner, Shape{ 64, std::vector<int>(2, 128), 8 }, 64);
+
+	return runner.finish();
+}
@@ -0,0 +1,130 @@
+/**
+ * @file	Activation.hpp.
+ *
+ * @brief	Declares the activation functions. They are defined here, so they inline into the
+ * 			forward passes and into user code.
+ */
+#ifndef ACTIVATION_H
+#define ACTIVATION_H
+
+#include <cmath>
+#include <string>
+
+#include "FastMath.hpp"
+
+namespace etunn
+{
+	/**
+	 * @enum	Activation
+	 *
+	 * @brief	The activation function of a layer.
+	 */
+	enum class Activation
+	{
+		/** @brief	Sigmoid curve, shaped by the activation response (Default). */
+		Sigmoid,
+
+		/** @brief	Hyperbolic tangent. */
+		Tanh,
+
+		/** @brief	Rectified linear unit. */
+		ReLU,
+
+		/** @brief	Identity, passes the activation through unchanged. */
+		Linear
+	};
+
+	/**
+	 * @fn	double activate(Activation function, double activation, double response, MathAccuracy accuracy = MathAccuracy::Exact);
+	 *
+	 * @brief	Applies an activation function.
+	 *
+	 * @param	function  	The activation function.
+	 * @param	activation	The activation.
+	 * @param	response  	The response (only used by the sigmoid curve).
+	 * @param	accuracy  	How exactly the sigmoid curve and tanh are calculated.
+	 *
+	 * @return	The output of the neuron.
+	 */
+	inline double activate(Activation function, double activation, double response, MathAccuracy accuracy = MathAccuracy::Exact)
+	{
+		switch (function)
+		{
+		case Activation::Tanh:
+			return fastmath::tanh(accuracy, activation);
+		case Activation::ReLU:
+			return activation > 0 ? activation : 0;
+		case Activation::Linear:
+			return activation;
+		default:
+			return fastmath::sigmoid(accuracy, activation / response);
+		}
+	}
+
+	/**
+	 * @fn	template<Activation function, MathAccuracy accuracy = MathAccuracy::Exact> inline double activate(double activation, double response)
+	 *
+	 * @brief	Applies an activation function chosen at compile time, so loops over a layer carry no switch.
+	 *
+	 * @tparam	function	The activation function.
+	 * @tparam	accuracy	How exactly the sigmoid curve and tanh are calculated.
+	 * @param 	activation	The activation.
+	 * @param 	response  	The response (only used by the sigmoid curve).
+	 *
+	 * @return	The output of the neuron.
+	 */
+	template<Activation function, MathAccuracy accuracy = MathAccuracy::Exact>
+	inline double activate(double activation, double response)
+	{
+		switch (function)
+		{
+		case Activation::Tanh:
+			return fastmath::tanh<accuracy>(activation);
+		case Activation::ReLU:
+			return activation > 0 ? activation : 0;
+		case Activation::Linear:
+			return activation;
+		default:
+			return fastmath::sigmoid<accuracy>(activation / response);
+		}
+	}
+
+	/**
+	 * @fn	double activationDerivative(Activation function, double output, double response);
+	 *
+	 * @brief	Gets the derivative of an activation function from the output it produced.
+	 *
+	 * @param	function	The activation function.
+	 * @param	output  	The output of the neuron.
+	 * @param	response	The response (only used by the sigmoid curve).
+	 *
+	 * @return	The derivative of the output with respect to the activation.
+	 */
+	inline double activationDerivative(Activation function, double output, double response)
+	{
+		switch (function)
+		{
+		case Activation::Tanh:
+			return 1 - output * output;
+		case Activation::ReLU:
+			return output > 0 ? 1 : 0;
+		case Activation::Linear:
+			return 1;
+		default:
+			return output * (1 - output) / response;
+		}
+	}
+
+	/**
+	 * @fn	std::string activationName(Activation function);
+	 *
+	 * @brief	Gets the name of an activation function.
+	 *
+	 * @param	function	The activation function.
+	 *
+	 * @return	The name.
+	 */
+	std::string activationName(Activation function);
+}
+
+#endif
@@ -0,0 +1,268 @@
+/**
+ * @file	Dataset.hpp.
+ *
+ * @brief	Declares the streaming dataset reader.
+ */
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace etunn
+{
+	/**
+	 * @enum	DatasetFormat
+	 *
+	 * @brief	The file formats the dataset reader understands.
+	 */
+	enum class DatasetFormat
+	{
+		/** @brief	Raw native-endian doubles, row after row, without a header. */
+		Binary,
+
+		/** @brief	Text with one row per line and the values separated by commas (or semicolons or tabs).
+		 * 			A first line that does not start with a number is skipped as a header. */
+		CSV
+	};
+
+	/**
+	 * @struct	Batch
+	 *
+	 * @brief	A batch of rows, each holding the inputs followed by the targets.
+	 * 			The values are only valid until the next call to DatasetReader::next().
+	 */
+	struct Batch
+	{
+		/** @brief	The values, row-major. */
+		const double *data;
+
+		/** @brief	Number of rows. */
+		int numRows;
+
+		/** @brief	Number of inputs per row. */
+		int numInputs;
+
+		/** @brief	Number of targets per row. */
+		int numTargets;
+
+		/**
+		 * @fn	Batch()
+		 *
+		 * @brief	Default constructor.
+		 */
+		Batch() : data(nullptr), numRows(0), numInputs(0), numTargets(0) {}
+
+		/**
+		 * @fn	const double* getInputs(int row) const
+		 *
+		 * @brief	Gets the inputs of a row (e.g. for NeuralNet::update(const double*, Params)).
+		 *
+		 * @param	row	The row.
+		 *
+		 * @return	The inputs.
+		 */
+		const double* getInputs(int row) const
+		{
+			return data + (std::size_t)row * (numInputs + numTargets);
+		}
+
+		/**
+		 * @fn	const double* getTargets(int row) const
+		 *
+		 * @brief	Gets the targets of a row.
+		 *
+		 * @param	row	The row.
+		 *
+		 * @return	The targets.
+		 */
+		const double* getTargets(int row) const
+		{
+			return getInputs(row) + numInputs;
+		}
+	};
+
+	/**
+	 * @class	DatasetReader
+	 *
+	 * @brief	Streams a dataset from a memory-mapped file in batches, so datasets larger than
+	 * 			the memory can be used. Binary batches point straight into the mapping; CSV batches
+	 * 			are parsed into a reused buffer. With prefetching on, a background thread prepares
+	 * 			the next batch (touching its pages or parsing it) while the current one is used.
+	 */
+	class DatasetReader
+	{
+	public:
+
+		/**
+		 * @fn	DatasetReader::DatasetReader();
+		 *
+		 * @brief	Default constructor.
+		 */
+		DatasetReader();
+
+		/**
+		 * @fn	DatasetReader::~DatasetReader();
+		 *
+		 * @brief	Destructor.
+		 */
+		~DatasetReader();
+
+		DatasetReader(const DatasetReader&) = delete;
+		DatasetReader& operator=(const DatasetReader&) = delete;
+
+		/**
+		 * @fn	bool DatasetReader::open(const std::string &path, DatasetFormat format, int numInputs, int numTargets, int batchSize, bool prefetch = true);
+		 *
+		 * @brief	Opens a dataset.
+		 *
+		 * @param	path	  	The path of the file.
+		 * @param	format	  	The format of the file.
+		 * @param	numInputs 	Number of inputs per row.
+		 * @param	numTargets	Number of targets per row (may be zero).
+		 * @param	batchSize 	Maximum number of rows per batch.
+		 * @param	prefetch  	True to prepare the next batch in a background thread.
+		 *
+		 * @return	True if successful, false if the file can not be mapped or (binary) its size
+		 * 			is not a multiple of the row size.
+		 */
+		bool open(const std::string &path, DatasetFormat format, int numInputs, int numTargets, int batchSize, bool prefetch = true);
+
+		/**
+		 * @fn	void DatasetReader::close();
+		 *
+		 * @brief	Closes the dataset.
+		 */
+		void close();
+
+		/**
+		 * @fn	bool DatasetReader::isOpen() const;
+		 *
+		 * @brief	Checks whether a dataset is open.
+		 *
+		 * @return	True if open.
+		 */
+		bool isOpen() const;
+
+		/**
+		 * @fn	bool DatasetReader::next(Batch &batch);
+		 *
+		 * @brief	Gets the next batch. The previous batch becomes invalid.
+		 *
+		 * @param [in,out]	batch	Set to the next batch.
+		 *
+		 * @return	True if successful, false at the end of the dataset.
+		 */
+		bool next(Batch &batch);
+
+		/**
+		 * @fn	void DatasetReader::rewind();
+		 *
+		 * @brief	Starts over at the first row (e.g. for the next training epoch).
+		 */
+		void rewind();
+
+		/**
+		 * @fn	long long DatasetReader::getNumRows() const;
+		 *
+		 * @brief	Gets the number of rows of a binary dataset.
+		 *
+		 * @return	The number of rows, or -1 for CSV (which would require a full scan).
+		 */
+		long long getNumRows() const;
+
+		/**
+		 * @fn	long long DatasetReader::getNumSkippedRows() const;
+		 *
+		 * @brief	Gets the number of malformed CSV rows skipped in the batches prepared so far.
+		 *
+		 * @return	The number of skipped rows.
+		 */
+		long long getNumSkippedRows() const;
+
+	private:
+
+		/**
+		 * @struct	Slot
+		 *
+		 * @brief	A batch being prepared or used.
+		 */
+		struct Slot
+		{
+			/** @brief	Parsed values (CSV only). */
+			std::vector<double> values;
+
+			/** @brief	The first value and the number of rows (zero at the end). */
+			const double *data;
+			int numRows;
+
+			/** @brief	True once the batch is prepared. */
+			bool ready;
+		};
+
+		DatasetFormat format;
+		int numInputs, numTargets, batchSize;
+		bool prefetch;
+
+		/** @brief	The mapped file. */
+		const char *mapping;
+		std::size_t mappingSize;
+		void *fileHandle, *mappingHandle;
+
+		/** @brief	Byte of the first row and of the next batch to prepare. */
+		std::size_t dataStart, cursor;
+
+		/** @brief	Counted by the prefetch thread. */
+		std::atomic<long long> skippedRows;
+
+		Slot slots[2];
+		int produceSlot, consumeSlot;
+		bool handedOut, producerDone, stopping;
+
+		std::thread worker;
+		std::mutex mutex;
+		std::condition_variable condition;
+
+		/**
+		 * @fn	void DatasetReader::produce(Slot &slot);
+		 *
+		 * @brief	Prepares the next batch in a slot.
+		 */
+		void produce(Slot &slot);
+
+		/**
+		 * @fn	void DatasetReader::parseCSV(Slot &slot);
+		 *
+		 * @brief	Parses the next batch of CSV rows.
+		 */
+		void parseCSV(Slot &slot);
+
+		/**
+		 * @fn	void DatasetReader::work();
+		 *
+		 * @brief	The loop of the prefetch thread.
+		 */
+		void work();
+
+		/**
+		 * @fn	void DatasetReader::start();
+		 *
+		 * @brief	Resets the batches to the first row and starts the prefetch thread if requested.
+		 */
+		void start();
+
+		/**
+		 * @fn	void DatasetReader::stop();
+		 *
+		 * @brief	Stops the prefetch thread.
+		 */
+		void stop();
+	};
+}
+
+#endif
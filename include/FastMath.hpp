@@ -0,0 +1,244 @@
+/**
+ * @file	FastMath.hpp.
+ *
+ * @brief	Declares approximations of the sigmoid curve and the hyperbolic tangent in several
+ * 			accuracy tiers. The scalar versions are defined here, so they inline into the forward passes.
+ */
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace etunn
+{
+	/**
+	 * @enum	MathAccuracy
+	 *
+	 * @brief	How exactly a net calculates its sigmoid and tanh activations.
+	 */
+	enum class MathAccuracy
+	{
+		/** @brief	Uses std::exp and std::tanh (Default). */
+		Exact,
+
+		/** @brief	A polynomial approximation of exp, accurate to about 1e-6. */
+		Polynomial,
+
+		/** @brief	Linear interpolation in a small table, accurate to about 1e-3. Good enough for
+		 * 			most evolved controllers. */
+		Table
+	};
+
+	/**
+	 * @fn	std::string mathAccuracyName(MathAccuracy accuracy);
+	 *
+	 * @brief	Gets the name of an accuracy tier.
+	 *
+	 * @param	accuracy	The accuracy tier.
+	 *
+	 * @return	The name.
+	 */
+	std::string mathAccuracyName(MathAccuracy accuracy);
+
+	namespace fastmath
+	{
+		/** @brief	The sigmoid curve sampled every 1 / tableScale from -tableRange to tableRange,
+		 * 			followed by a copy of the last entry. */
+		extern const double sigmoidTable[];
+
+		/** @brief	Half the range covered by sigmoidTable. */
+		const double tableRange = 8;
+
+		/** @brief	Number of entries of sigmoidTable per unit. */
+		const double tableScale = 8;
+
+		/** @brief	Index of the last entry of sigmoidTable, not counting the copy. */
+		const int tableLast = 128;
+
+		/**
+		 * @fn	inline double polynomialExp(double x)
+		 *
+		 * @brief	Approximates e^x as 2^n * e^r with |r| <= ln(2) / 2, e^r being a polynomial of degree 5.
+		 * 			The relative error is below 3e-6. Arguments beyond +-708 are clamped.
+		 *
+		 * @param	x	The exponent.
+		 *
+		 * @return	e^x.
+		 */
+		inline double polynomialExp(double x)
+		{
+			//Adding 1.5 * 2^52 rounds to an integer, which ends up in the low bits of the mantissa
+			const double shifter = 6755399441055744.0;
+
+			x = x < -708 ? -708 : (x > 708 ? 708 : x);
+
+			double t = x * 1.4426950408889634 + shifter;
+			double n = t - shifter;
+			double r = x - n * 0.6931471803691238 - n * 1.9082149292705877e-10;
+			//Estrin's scheme, shorter dependency chains than Horner's
+			double r2 = r * r;
+			double p = (1 + r) + r2 * ((0.5 + r * (1.0 / 6)) + r2 * (1.0 / 24 + r * (1.0 / 120)));
+
+			//Move n + 1023 into the exponent to get 2^n
+			std::uint64_t bits;
+			std::memcpy(&bits, &t, sizeof(bits));
+			bits = (bits + 1023) << 52;
+
+			double scale;
+			std::memcpy(&scale, &bits, sizeof(scale));
+
+			return p * scale;
+		}
+
+		/**
+		 * @fn	inline double tableSigmoid(double x)
+		 *
+		 * @brief	Approximates the sigmoid curve by linear interpolation in sigmoidTable. The absolute
+		 * 			error is below 4e-4.
+		 *
+		 * @param	x	The argument.
+		 *
+		 * @return	1 / (1 + e^-x).
+		 */
+		inline double tableSigmoid(double x)
+		{
+			//NaN must not reach the cast, it stays NaN like in the other tiers
+			if (x != x)
+			{
+				return x;
+			}
+
+			double t = (x + tableRange) * tableScale;
+
+			if (!(t > 0))
+			{
+				t = 0;
+			}
+			else if (t > tableLast)
+			{
+				t = tableLast;
+			}
+
+			int i = (int)t;
+			double fraction = t - i;
+
+			return sigmoidTable[i] + fraction * (sigmoidTable[i + 1] - sigmoidTable[i]);
+		}
+
+		/**
+		 * @fn	template<MathAccuracy accuracy> inline double sigmoid(double x)
+		 *
+		 * @brief	The sigmoid curve 1 / (1 + e^-x) in an accuracy tier chosen at compile time.
+		 *
+		 * @tparam	accuracy	The accuracy tier.
+		 * @param 	x			The argument.
+		 *
+		 * @return	The sigmoid of x.
+		 */
+		template<MathAccuracy accuracy>
+		inline double sigmoid(double x)
+		{
+			switch (accuracy)
+			{
+			case MathAccuracy::Polynomial:
+				return 1 / (1 + polynomialExp(-x));
+			case MathAccuracy::Table:
+				return tableSigmoid(x);
+			default:
+				return 1 / (1 + std::exp(-x));
+			}
+		}
+
+		/**
+		 * @fn	template<MathAccuracy accuracy> inline double tanh(double x)
+		 *
+		 * @brief	The hyperbolic tangent in an accuracy tier chosen at compile time. The approximations
+		 * 			use tanh(x) = 2 * sigmoid(2x) - 1, which doubles their error.
+		 *
+		 * @tparam	accuracy	The accuracy tier.
+		 * @param 	x			The argument.
+		 *
+		 * @return	The hyperbolic tangent of x.
+		 */
+		template<MathAccuracy accuracy>
+		inline double tanh(double x)
+		{
+			switch (accuracy)
+			{
+			case MathAccuracy::Polynomial:
+				return 2 / (1 + polynomialExp(-2 * x)) - 1;
+			case MathAccuracy::Table:
+				return 2 * tableSigmoid(2 * x) - 1;
+			default:
+				return std::tanh(x);
+			}
+		}
+
+		/**
+		 * @fn	inline double sigmoid(MathAccuracy accuracy, double x)
+		 *
+		 * @brief	The sigmoid curve in an accuracy tier chosen at run time.
+		 */
+		inline double sigmoid(MathAccuracy accuracy, double x)
+		{
+			switch (accuracy)
+			{
+			case MathAccuracy::Polynomial:
+				return sigmoid<MathAccuracy::Polynomial>(x);
+			case MathAccuracy::Table:
+				return sigmoid<MathAccuracy::Table>(x);
+			default:
+				return sigmoid<MathAccuracy::Exact>(x);
+			}
+		}
+
+		/**
+		 * @fn	inline double tanh(MathAccuracy accuracy, double x)
+		 *
+		 * @brief	The hyperbolic tangent in an accuracy tier chosen at run time.
+		 */
+		inline double tanh(MathAccuracy accuracy, double x)
+		{
+			switch (accuracy)
+			{
+			case MathAccuracy::Polynomial:
+				return tanh<MathAccuracy::Polynomial>(x);
+			case MathAccuracy::Table:
+				return tanh<MathAccuracy::Table>(x);
+			default:
+				return tanh<MathAccuracy::Exact>(x);
+			}
+		}
+
+		/**
+		 * @fn	void sigmoid(MathAccuracy accuracy, const double *inputs, double *outputs, int count, double response);
+		 *
+		 * @brief	Calculates the sigmoid curve 1 / (1 + e^(-x / response)) of many values. The polynomial
+		 * 			tier runs on AVX or SSE2 vectors; the other tiers are scalar loops.
+		 *
+		 * @param 		  	accuracy	The accuracy tier.
+		 * @param 		  	inputs  	The arguments.
+		 * @param [in,out]	outputs 	Receives the results, may be the same as inputs.
+		 * @param 		  	count   	Number of values.
+		 * @param 		  	response	The activation response.
+		 */
+		void sigmoid(MathAccuracy accuracy, const double *inputs, double *outputs, int count, double response);
+
+		/**
+		 * @fn	void tanh(MathAccuracy accuracy, const double *inputs, double *outputs, int count);
+		 *
+		 * @brief	Calculates the hyperbolic tangent of many values, vectorized like sigmoid() above.
+		 *
+		 * @param 		  	accuracy	The accuracy tier.
+		 * @param 		  	inputs  	The arguments.
+		 * @param [in,out]	outputs 	Receives the results, may be the same as inputs.
+		 * @param 		  	count   	Number of values.
+		 */
+		void tanh(MathAccuracy accuracy, const double *inputs, double *outputs, int count);
+	}
+}
+
+#endif
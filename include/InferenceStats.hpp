@@ -0,0 +1,334 @@
+/**
+ * @file	InferenceStats.hpp.
+ *
+ * @brief	Declares the latency histogram and the inference statistics of the neural nets.
+ */
+#ifndef INFERENCESTATS_H
+#define INFERENCESTATS_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace etunn
+{
+	/**
+	 * @class	LatencyHistogram
+	 *
+	 * @brief	A histogram of latencies in nanoseconds with HDR-style log-linear buckets:
+	 * 			every power of two is split into 32 buckets, so percentiles are exact below
+	 * 			32 ns and within about 3% above, up to 2^40 ns. Recording is lock-free.
+	 */
+	class LatencyHistogram
+	{
+	public:
+
+		/**
+		 * @fn	LatencyHistogram::LatencyHistogram();
+		 *
+		 * @brief	Default constructor.
+		 */
+		LatencyHistogram();
+
+		/**
+		 * @fn	LatencyHistogram::LatencyHistogram(const LatencyHistogram &other);
+		 *
+		 * @brief	Copy constructor.
+		 *
+		 * @param	other	The histogram to copy.
+		 */
+		LatencyHistogram(const LatencyHistogram &other);
+
+		/**
+		 * @fn	LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram &other);
+		 *
+		 * @brief	Assignment operator.
+		 *
+		 * @param	other	The histogram to copy.
+		 *
+		 * @return	This histogram.
+		 */
+		LatencyHistogram& operator=(const LatencyHistogram &other);
+
+		/**
+		 * @fn	void LatencyHistogram::record(long long nanoseconds);
+		 *
+		 * @brief	Records a latency.
+		 *
+		 * @param	nanoseconds	The latency.
+		 */
+		void record(long long nanoseconds);
+
+		/**
+		 * @fn	long long LatencyHistogram::getCount() const;
+		 *
+		 * @brief	Gets the number of recorded latencies.
+		 *
+		 * @return	The count.
+		 */
+		long long getCount() const;
+
+		/**
+		 * @fn	double LatencyHistogram::getMean() const;
+		 *
+		 * @brief	Gets the mean latency in nanoseconds.
+		 *
+		 * @return	The mean, or zero if nothing was recorded.
+		 */
+		double getMean() const;
+
+		/**
+		 * @fn	long long LatencyHistogram::getMax() const;
+		 *
+		 * @brief	Gets the highest recorded latency in nanoseconds.
+		 *
+		 * @return	The maximum.
+		 */
+		long long getMax() const;
+
+		/**
+		 * @fn	long long LatencyHistogram::getPercentile(double percentile) const;
+		 *
+		 * @brief	Gets the latency below or at which the given percentage of the calls completed.
+		 *
+		 * @param	percentile	The percentile, from 0 to 100 (e.g. 99.9).
+		 *
+		 * @return	The upper bound of the bucket holding the percentile in nanoseconds,
+		 * 			or zero if nothing was recorded.
+		 */
+		long long getPercentile(double percentile) const;
+
+		/**
+		 * @fn	void LatencyHistogram::reset();
+		 *
+		 * @brief	Discards all recorded latencies.
+		 */
+		void reset();
+
+	private:
+		static const int subBucketBits = 5;
+		static const int subBucketCount = 1 << subBucketBits;
+		static const int maxExponent = 40;
+		static const int numBuckets = (maxExponent - subBucketBits + 1) * subBucketCount;
+
+		/** @brief	Number of latencies in each bucket. */
+		std::atomic<long long> buckets[numBuckets];
+
+		/** @brief	Number of recorded latencies. */
+		std::atomic<long long> count;
+
+		/** @brief	Sum of the recorded latencies. */
+		std::atomic<long long> total;
+
+		/** @brief	Highest recorded latency. */
+		std::atomic<long long> max;
+
+		/**
+		 * @fn	static int LatencyHistogram::bucketIndex(long long nanoseconds);
+		 *
+		 * @brief	Gets the bucket of a latency.
+		 */
+		static int bucketIndex(long long nanoseconds);
+
+		/**
+		 * @fn	static long long LatencyHistogram::bucketUpperBound(int index);
+		 *
+		 * @brief	Gets the highest latency that falls into a bucket.
+		 */
+		static long long bucketUpperBound(int index);
+	};
+
+	/**
+	 * @class	InferenceStats
+	 *
+	 * @brief	Call count, latency histogram and per-layer time of a network's update().
+	 * 			Collected by the nets only when the library is built with ETUNN_INSTRUMENTATION.
+	 */
+	class InferenceStats
+	{
+	public:
+
+		/**
+		 * @fn	InferenceStats::InferenceStats(int numLayers = 0);
+		 *
+		 * @brief	Constructor.
+		 *
+		 * @param	numLayers	Number of layers, including the output layer.
+		 */
+		InferenceStats(int numLayers = 0);
+
+		/**
+		 * @fn	InferenceStats::InferenceStats(const InferenceStats &other);
+		 *
+		 * @brief	Copy constructor.
+		 *
+		 * @param	other	The statistics to copy.
+		 */
+		InferenceStats(const InferenceStats &other);
+
+		/**
+		 * @fn	InferenceStats& InferenceStats::operator=(const InferenceStats &other);
+		 *
+		 * @brief	Assignment operator.
+		 *
+		 * @param	other	The statistics to copy.
+		 *
+		 * @return	These statistics.
+		 */
+		InferenceStats& operator=(const InferenceStats &other);
+
+		/**
+		 * @fn	void InferenceStats::recordCall(long long nanoseconds);
+		 *
+		 * @brief	Records one call of update().
+		 *
+		 * @param	nanoseconds	The latency of the call.
+		 */
+		void recordCall(long long nanoseconds);
+
+		/**
+		 * @fn	void InferenceStats::recordLayer(int layer, long long nanoseconds);
+		 *
+		 * @brief	Adds time spent in a layer.
+		 *
+		 * @param	layer	   	The layer.
+		 * @param	nanoseconds	The time.
+		 */
+		void recordLayer(int layer, long long nanoseconds);
+
+		/**
+		 * @fn	long long InferenceStats::getCallCount() const;
+		 *
+		 * @brief	Gets the number of calls.
+		 *
+		 * @return	The number of calls.
+		 */
+		long long getCallCount() const;
+
+		/**
+		 * @fn	const LatencyHistogram& InferenceStats::getLatency() const;
+		 *
+		 * @brief	Gets the latency histogram of the calls.
+		 *
+		 * @return	The histogram.
+		 */
+		const LatencyHistogram& getLatency() const;
+
+		/**
+		 * @fn	int InferenceStats::getNumLayers() const;
+		 *
+		 * @brief	Gets the number of layers.
+		 *
+		 * @return	The number of layers.
+		 */
+		int getNumLayers() const;
+
+		/**
+		 * @fn	double InferenceStats::getLayerSeconds(int layer) const;
+		 *
+		 * @brief	Gets the total time spent in a layer.
+		 *
+		 * @param	layer	The layer.
+		 *
+		 * @return	The time in seconds.
+		 */
+		double getLayerSeconds(int layer) const;
+
+		/**
+		 * @fn	void InferenceStats::reset();
+		 *
+		 * @brief	Discards all recorded calls.
+		 */
+		void reset();
+
+		/**
+		 * @fn	std::string InferenceStats::toString() const;
+		 *
+		 * @brief	Summarises the calls, the p50/p90/p99/p99.9 latencies and the share of time per layer.
+		 *
+		 * @return	The summary.
+		 */
+		std::string toString() const;
+
+	private:
+		int numLayers;
+		LatencyHistogram latency;
+		std::unique_ptr<std::atomic<long long>[]> layerNanoseconds;
+	};
+
+	/**
+	 * @class	InferenceTimer
+	 *
+	 * @brief	Times one call of update() and its layers, recording the call when it goes out of scope.
+	 */
+	class InferenceTimer
+	{
+	public:
+
+		/**
+		 * @fn	InferenceTimer::InferenceTimer(InferenceStats &stats)
+		 *
+		 * @brief	Constructor. Starts timing.
+		 *
+		 * @param [in,out]	stats	The statistics to record into.
+		 */
+		InferenceTimer(InferenceStats &stats)
+			: stats(stats),
+			start(std::chrono::steady_clock::now()),
+			layerStart(start)
+		{
+		}
+
+		/**
+		 * @fn	void InferenceTimer::layerDone(int layer)
+		 *
+		 * @brief	Records the time since the previous layer as spent in the given layer.
+		 *
+		 * @param	layer	The layer that just finished.
+		 */
+		void layerDone(int layer)
+		{
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			stats.recordLayer(layer, std::chrono::duration_cast<std::chrono::nanoseconds>(now - layerStart).count());
+			layerStart = now;
+		}
+
+		/**
+		 * @fn	InferenceTimer::~InferenceTimer()
+		 *
+		 * @brief	Destructor. Records the call.
+		 */
+		~InferenceTimer()
+		{
+			stats.recordCall(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count());
+		}
+
+	private:
+		InferenceStats &stats;
+		std::chrono::steady_clock::time_point start;
+		std::chrono::steady_clock::time_point layerStart;
+	};
+}
+
+/**
+ * @def	ETUNN_TIME_UPDATE(stats)
+ *
+ * @brief	Times the enclosing update() into stats. Expands to nothing without ETUNN_INSTRUMENTATION.
+ */
+
+/**
+ * @def	ETUNN_TIME_LAYER(layer)
+ *
+ * @brief	Marks the end of a layer inside a timed update(). Expands to nothing without ETUNN_INSTRUMENTATION.
+ */
+#ifdef ETUNN_INSTRUMENTATION
+#define ETUNN_TIME_UPDATE(stats) etunn::InferenceTimer etunnInferenceTimer(stats)
+#define ETUNN_TIME_LAYER(layer) etunnInferenceTimer.layerDone(layer)
+#else
+#define ETUNN_TIME_UPDATE(stats) ((void)0)
+#define ETUNN_TIME_LAYER(layer) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+/**
+ * @file	Kernels.hpp.
+ *
+ * @brief	Declares the forward kernels of the dense nets. They are header-only, so the forward pass
+ * 			inlines into code calling NeuralNet::update() in a tight loop.
+ */
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "Activation.hpp"
+#include "NeuronLayer.hpp"
+
+namespace etunn
+{
+	namespace kernels
+	{
+		/**
+		 * @fn	inline double dot(const double *weights, const double *inputs, int n)
+		 *
+		 * @brief	Sums up weights * inputs. Four independent sums let the compiler vectorize the
+		 * 			loop without reordering floating point additions on its own.
+		 *
+		 * @param	weights	The weights.
+		 * @param	inputs 	The inputs.
+		 * @param	n	   	Number of inputs.
+		 *
+		 * @return	The sum.
+		 */
+		inline double dot(const double *weights, const double *inputs, int n)
+		{
+			double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+			int k = 0;
+
+			for (; k + 4 <= n; k += 4)
+			{
+				sum0 += weights[k] * inputs[k];
+				sum1 += weights[k + 1] * inputs[k + 1];
+				sum2 += weights[k + 2] * inputs[k + 2];
+				sum3 += weights[k + 3] * inputs[k + 3];
+			}
+
+			for (; k < n; ++k)
+			{
+				sum0 += weights[k] * inputs[k];
+			}
+
+			return (sum0 + sum1) + (sum2 + sum3);
+		}
+
+		/**
+		 * @fn	template<Activation function, MathAccuracy accuracy> inline void denseLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		 *
+		 * @brief	Calculates the outputs of a layer whose weights are stored in its neurons.
+		 *
+		 * @tparam		  	function	The activation function of the layer.
+		 * @tparam		  	accuracy	How exactly the activation function is calculated.
+		 * @param 		  	layer   	The layer.
+		 * @param 		  	inputs  	The inputs of the layer.
+		 * @param [in,out]	outputs 	Receives the outputs of the layer.
+		 * @param 		  	bias	 	The bias input.
+		 * @param 		  	response	The activation response.
+		 */
+		template<Activation function, MathAccuracy accuracy>
+		inline void denseLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		{
+			for (int j = 0; j < layer.numNeurons; ++j)
+			{
+				//The bias weight follows the input weights
+				int numInputs = layer.neurons[j].numInputs - 1;
+				const double *weights = layer.neurons[j].weights.data();
+
+				outputs[j] = activate<function, accuracy>(dot(weights, inputs, numInputs) + weights[numInputs] * bias, response);
+			}
+		}
+
+		/**
+		 * @fn	template<Activation function, MathAccuracy accuracy> inline void sparseLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		 *
+		 * @brief	Calculates the outputs of a compressed layer, touching only its non-zero weights.
+		 *
+		 * @tparam		  	function	The activation function of the layer.
+		 * @tparam		  	accuracy	How exactly the activation function is calculated.
+		 * @param 		  	layer   	The layer.
+		 * @param 		  	inputs  	The inputs of the layer.
+		 * @param [in,out]	outputs 	Receives the outputs of the layer.
+		 * @param 		  	bias	 	The bias input.
+		 * @param 		  	response	The activation response.
+		 */
+		template<Activation function, MathAccuracy accuracy>
+		inline void sparseLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		{
+			const int *columns = layer.columns.data();
+			const double *values = layer.values.data();
+
+			for (int j = 0; j < layer.numNeurons; ++j)
+			{
+				double netinput = layer.biasWeights[j] * bias;
+
+				for (int e = layer.rowStart[j]; e < layer.rowStart[j + 1]; ++e)
+				{
+					netinput += values[e] * inputs[columns[e]];
+				}
+
+				outputs[j] = activate<function, accuracy>(netinput, response);
+			}
+		}
+
+		/**
+		 * @fn	template<Activation function, MathAccuracy accuracy> inline void forwardLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		 *
+		 * @brief	Calculates the outputs of a dense or compressed layer.
+		 */
+		template<Activation function, MathAccuracy accuracy>
+		inline void forwardLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		{
+			if (layer.sparse)
+			{
+				sparseLayer<function, accuracy>(layer, inputs, outputs, bias, response);
+			}
+			else
+			{
+				denseLayer<function, accuracy>(layer, inputs, outputs, bias, response);
+			}
+		}
+
+		/**
+		 * @fn	template<Activation function> inline void forwardLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		 *
+		 * @brief	Calculates the outputs of a layer, choosing the accuracy of its activation function.
+		 */
+		template<Activation function>
+		inline void forwardLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		{
+			switch (layer.accuracy)
+			{
+			case MathAccuracy::Polynomial:
+				forwardLayer<function, MathAccuracy::Polynomial>(layer, inputs, outputs, bias, response);
+				break;
+			case MathAccuracy::Table:
+				forwardLayer<function, MathAccuracy::Table>(layer, inputs, outputs, bias, response);
+				break;
+			default:
+				forwardLayer<function, MathAccuracy::Exact>(layer, inputs, outputs, bias, response);
+				break;
+			}
+		}
+
+		/**
+		 * @fn	inline void forwardLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		 *
+		 * @brief	Calculates the outputs of a layer, choosing the activation once per layer
+		 * 			instead of once per neuron.
+		 *
+		 * @param 		  	layer   	The layer.
+		 * @param 		  	inputs  	The inputs of the layer.
+		 * @param [in,out]	outputs 	Receives the outputs of the layer.
+		 * @param 		  	bias	 	The bias input.
+		 * @param 		  	response	The activation response.
+		 */
+		inline void forwardLayer(const NeuronLayer &layer, const double *inputs, double *outputs, double bias, double response)
+		{
+			switch (layer.activation)
+			{
+			case Activation::Tanh:
+				forwardLayer<Activation::Tanh>(layer, inputs, outputs, bias, response);
+				break;
+			case Activation::ReLU:
+				forwardLayer<Activation::ReLU, MathAccuracy::Exact>(layer, inputs, outputs, bias, response);
+				break;
+			case Activation::Linear:
+				forwardLayer<Activation::Linear, MathAccuracy::Exact>(layer, inputs, outputs, bias, response);
+				break;
+			default:
+				forwardLayer<Activation::Sigmoid>(layer, inputs, outputs, bias, response);
+				break;
+			}
+		}
+	}
+}
+
+#endif
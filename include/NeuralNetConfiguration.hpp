@@ -8,6 +8,8 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include "Activation.hpp"
 
 namespace etunn
 {
@@ -55,6 +57,30 @@ namespace etunn
 		 */
 		NeuralNetConfiguration& neuronsPerLayer(int n);
 
+		/**
+		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::hiddenLayerSizes(std::vector<int> sizes);
+		 *
+		 * @brief	The amount of neurons of each hidden layer (Default = empty).
+		 * 			Overrides numHidden and neuronsPerLayer when not empty.
+		 *
+		 * @param	sizes	The sizes of the hidden layers.
+		 *
+		 * @return	This object.
+		 */
+		NeuralNetConfiguration& hiddenLayerSizes(std::vector<int> sizes);
+
+		/**
+		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::layerActivations(std::vector<Activation> functions);
+		 *
+		 * @brief	The activation function of each layer, including the output layer (Default = empty).
+		 * 			Layers without an entry use the sigmoid curve.
+		 *
+		 * @param	functions	The activation functions.
+		 *
+		 * @return	This object.
+		 */
+		NeuralNetConfiguration& layerActivations(std::vector<Activation> functions);
+
 		/**
 		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::numOutputs(int n);
 		 *
@@ -78,6 +104,18 @@ namespace etunn
 		 */
 		NeuralNetConfiguration& activationResponse(double n);
 
+		/**
+		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::mathAccuracy(MathAccuracy accuracy);
+		 *
+		 * @brief	How exactly the sigmoid curve and tanh are calculated (Default = MathAccuracy::Exact).
+		 * 			The approximations are considerably faster.
+		 *
+		 * @param	accuracy	The accuracy tier.
+		 *
+		 * @return	This object.
+		 */
+		NeuralNetConfiguration& mathAccuracy(MathAccuracy accuracy);
+
 		/**
 		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::bias(double n);
 		 *
@@ -144,6 +182,39 @@ namespace etunn
 		 */
 		NeuralNetConfiguration& numCopiesElite(int n);
 
+		/**
+		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::compatibilityThreshold(double n);
+		 *
+		 * @brief	The maximum compatibility distance of two genomes of the same species (NEAT only) (Default = 3)
+		 *
+		 * @param	n	The double to process.
+		 *
+		 * @return	This object.
+		 */
+		NeuralNetConfiguration& compatibilityThreshold(double n);
+
+		/**
+		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::addNodeRate(double n);
+		 *
+		 * @brief	The probability of adding a hidden node to an offspring (NEAT only) (Default = 0.03)
+		 *
+		 * @param	n	The double to process.
+		 *
+		 * @return	This object.
+		 */
+		NeuralNetConfiguration& addNodeRate(double n);
+
+		/**
+		 * @fn	NeuralNetConfiguration& NeuralNetConfiguration::addConnectionRate(double n);
+		 *
+		 * @brief	The probability of adding a connection to an offspring (NEAT only) (Default = 0.05)
+		 *
+		 * @param	n	The double to process.
+		 *
+		 * @return	This object.
+		 */
+		NeuralNetConfiguration& addConnectionRate(double n);
+
 		/**
 		 * @fn	std::string NeuralNetConfiguration::outputConfig();
 		 *
@@ -182,6 +253,24 @@ namespace etunn
 		 */
 		int getNeuronsPerHiddenLayer();
 
+		/**
+		 * @fn	std::vector<int> NeuralNetConfiguration::getHiddenLayerSizes();
+		 *
+		 * @brief	Gets the number of neurons of each hidden layer.
+		 *
+		 * @return	The sizes of the hidden layers.
+		 */
+		std::vector<int> getHiddenLayerSizes();
+
+		/**
+		 * @fn	std::vector<Activation> NeuralNetConfiguration::getLayerActivations();
+		 *
+		 * @brief	Gets the activation function of each layer, including the output layer.
+		 *
+		 * @return	The activation functions.
+		 */
+		std::vector<Activation> getLayerActivations();
+
 		/**
 		 * @fn	int NeuralNetConfiguration::getNumOutputs();
 		 *
@@ -200,6 +289,15 @@ namespace etunn
 		 */
 		double getActivationResponse();
 
+		/**
+		 * @fn	MathAccuracy NeuralNetConfiguration::getMathAccuracy();
+		 *
+		 * @brief	Gets the accuracy tier of the sigmoid curve and tanh.
+		 *
+		 * @return	The accuracy tier.
+		 */
+		MathAccuracy getMathAccuracy();
+
 		/**
 		 * @fn	double NeuralNetConfiguration::getBias();
 		 *
@@ -254,18 +352,51 @@ namespace etunn
 		 */
 		int getNumCopiesElite();
 
+		/**
+		 * @fn	double NeuralNetConfiguration::getCompatibilityThreshold();
+		 *
+		 * @brief	Gets the compatibility threshold (NEAT only).
+		 *
+		 * @return	The compatibility threshold.
+		 */
+		double getCompatibilityThreshold();
+
+		/**
+		 * @fn	double NeuralNetConfiguration::getAddNodeRate();
+		 *
+		 * @brief	Gets the probability of adding a node (NEAT only).
+		 *
+		 * @return	The add node rate.
+		 */
+		double getAddNodeRate();
+
+		/**
+		 * @fn	double NeuralNetConfiguration::getAddConnectionRate();
+		 *
+		 * @brief	Gets the probability of adding a connection (NEAT only).
+		 *
+		 * @return	The add connection rate.
+		 */
+		double getAddConnectionRate();
+
 	private:
 		int loc_numInputs;
 		int loc_numHidden;
 		int loc_neuronsPerHiddenLayer;
 		int loc_numOutputs;
+		std::vector<int> loc_hiddenLayerSizes;
+		std::vector<Activation> loc_layerActivations;
 		double loc_activationResponse;
+		MathAccuracy loc_mathAccuracy;
 		double loc_bias;
 		double loc_crossoverRate;
 		double loc_mutationRate;
 		double loc_maxPerturbation;
 		int loc_numElite;
 		int loc_numCopiesElite;
+		double loc_compatibilityThreshold;
+		double loc_addNodeRate;
+		double loc_addConnectionRate;
 	};
 }
 
@@ -21,6 +21,15 @@ namespace etunn
 		 */
 		Neuron(int numInputs);
 
+		/**
+		 * @fn	Neuron(const std::vector<double> &weights);
+		 *
+		 * @brief	Constructor.
+		 *
+		 * @param	weights	The weights, bias last.
+		 */
+		Neuron(const std::vector<double> &weights);
+
 		/** @brief	The number of inputs into the neuron. */
 		int numInputs;
 
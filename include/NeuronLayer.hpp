@@ -7,6 +7,7 @@
 #define NEURONLAYER_H
 
 #include <vector>
+#include "Activation.hpp"
 #include "Neuron.hpp"
 
 namespace etunn
@@ -14,20 +15,80 @@ namespace etunn
 	struct NeuronLayer
 	{
 		/**
-		 * @fn	NeuronLayer(int numNeurons, int numInputsPerNeuron);
+		 * @fn	NeuronLayer(int numNeurons, int numInputsPerNeuron, Activation activation = Activation::Sigmoid, MathAccuracy accuracy = MathAccuracy::Exact);
 		 *
 		 * @brief	Constructor.
 		 *
 		 * @param	numNeurons		  	Number of neurons.
 		 * @param	numInputsPerNeuron	Number of inputs per neurons.
+		 * @param	activation		  	The activation function of the layer.
+		 * @param	accuracy		  	How exactly the activation function is calculated.
 		 */
-		NeuronLayer(int numNeurons, int numInputsPerNeuron);
+		NeuronLayer(int numNeurons, int numInputsPerNeuron, Activation activation = Activation::Sigmoid, MathAccuracy accuracy = MathAccuracy::Exact);
 
 		/** @brief	Number of neurons in this layer. */
 		int numNeurons;
 
-		/** @brief	The layer of neurons. */
+		/** @brief	The activation function applied to the outputs of this layer. */
+		Activation activation;
+
+		/** @brief	How exactly the activation function is calculated. */
+		MathAccuracy accuracy;
+
+		/** @brief	Number of inputs per neuron (without the bias). */
+		int numInputsPerNeuron;
+
+		/** @brief	The layer of neurons (empty while the layer is sparse). */
 		std::vector<Neuron> neurons;
+
+		/** @brief	True if the weights are stored in the compressed rows below instead of in the neurons. */
+		bool sparse;
+
+		/** @brief	Index into columns/values where the non-zero weights of each neuron start (sparse only). */
+		std::vector<int> rowStart;
+
+		/** @brief	The input index of each non-zero weight (sparse only). */
+		std::vector<int> columns;
+
+		/** @brief	The non-zero weights (sparse only). */
+		std::vector<double> values;
+
+		/** @brief	The bias weight of each neuron (sparse only). */
+		std::vector<double> biasWeights;
+
+		/**
+		 * @fn	double getDensity() const;
+		 *
+		 * @brief	Gets the share of weights (including biases) that are not zero.
+		 *
+		 * @return	The density.
+		 */
+		double getDensity() const;
+
+		/**
+		 * @fn	std::vector<double> getNeuronWeights(int neuron) const;
+		 *
+		 * @brief	Gets all weights of a neuron, bias last, no matter how the layer is stored.
+		 *
+		 * @param	neuron	The neuron.
+		 *
+		 * @return	The weights.
+		 */
+		std::vector<double> getNeuronWeights(int neuron) const;
+
+		/**
+		 * @fn	void compress();
+		 *
+		 * @brief	Moves the non-zero weights into compressed rows and frees the dense weights.
+		 */
+		void compress();
+
+		/**
+		 * @fn	void decompress();
+		 *
+		 * @brief	Moves the weights back into the neurons.
+		 */
+		void decompress();
 	};
 }
 
@@ -0,0 +1,209 @@
+/**
+ * @file	Optimizer.hpp.
+ *
+ * @brief	Declares the gradient descent optimizers.
+ */
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <string>
+#include <vector>
+
+namespace etunn
+{
+	/**
+	 * @enum	OptimizerType
+	 *
+	 * @brief	The update rule of an optimizer.
+	 */
+	enum class OptimizerType
+	{
+		/** @brief	Plain gradient descent: w -= rate * g. */
+		SGD,
+
+		/** @brief	Gradient descent with momentum: v = momentum * v - rate * g, w += v. */
+		Momentum,
+
+		/** @brief	Divides by a running average of the squared gradients: s = decay * s + (1 - decay) * g^2, w -= rate * g / (sqrt(s) + epsilon). */
+		RMSProp,
+
+		/** @brief	Adam: bias-corrected running averages of the gradients and their squares. */
+		Adam
+	};
+
+	/**
+	 * @class	Optimizer
+	 *
+	 * @brief	Applies gradients to weights. The state of the optimizer (velocities, running
+	 * 			averages) is kept in flat buffers parallel to the weights, and each update rule
+	 * 			is one fused pass over gradient, state and weight, vectorized with AVX or SSE2
+	 * 			when the compiler targets them.
+	 *
+	 * 			Set it up with the fluent setters, e.g.
+	 * 			Optimizer(OptimizerType::Adam, 0.001).beta1(0.9).beta2(0.999);
+	 */
+	class Optimizer
+	{
+	public:
+
+		/**
+		 * @fn	Optimizer::Optimizer(OptimizerType type = OptimizerType::SGD, double learningRate = 0.01);
+		 *
+		 * @brief	Constructor.
+		 *
+		 * @param	type			The update rule.
+		 * @param	learningRate	The learning rate.
+		 */
+		Optimizer(OptimizerType type = OptimizerType::SGD, double learningRate = 0.01);
+
+		/**
+		 * @fn	Optimizer& Optimizer::learningRate(double learningRate);
+		 *
+		 * @brief	Sets the learning rate.
+		 *
+		 * @param	learningRate	The learning rate (Default: 0.01).
+		 *
+		 * @return	This optimizer.
+		 */
+		Optimizer& learningRate(double learningRate);
+
+		/**
+		 * @fn	Optimizer& Optimizer::momentum(double momentum);
+		 *
+		 * @brief	Sets the momentum (Momentum only).
+		 *
+		 * @param	momentum	The momentum (Default: 0.9).
+		 *
+		 * @return	This optimizer.
+		 */
+		Optimizer& momentum(double momentum);
+
+		/**
+		 * @fn	Optimizer& Optimizer::decay(double decay);
+		 *
+		 * @brief	Sets the decay of the running average of the squared gradients (RMSProp only).
+		 *
+		 * @param	decay	The decay (Default: 0.9).
+		 *
+		 * @return	This optimizer.
+		 */
+		Optimizer& decay(double decay);
+
+		/**
+		 * @fn	Optimizer& Optimizer::beta1(double beta1);
+		 *
+		 * @brief	Sets the decay of the running average of the gradients (Adam only).
+		 *
+		 * @param	beta1	The decay (Default: 0.9).
+		 *
+		 * @return	This optimizer.
+		 */
+		Optimizer& beta1(double beta1);
+
+		/**
+		 * @fn	Optimizer& Optimizer::beta2(double beta2);
+		 *
+		 * @brief	Sets the decay of the running average of the squared gradients (Adam only).
+		 *
+		 * @param	beta2	The decay (Default: 0.999).
+		 *
+		 * @return	This optimizer.
+		 */
+		Optimizer& beta2(double beta2);
+
+		/**
+		 * @fn	Optimizer& Optimizer::epsilon(double epsilon);
+		 *
+		 * @brief	Sets the term keeping RMSProp and Adam from dividing by zero.
+		 *
+		 * @param	epsilon	The epsilon (Default: 1e-8).
+		 *
+		 * @return	This optimizer.
+		 */
+		Optimizer& epsilon(double epsilon);
+
+		/**
+		 * @fn	void Optimizer::reset(int numWeights);
+		 *
+		 * @brief	Clears the state and sizes it for a number of weights.
+		 *
+		 * @param	numWeights	Number of weights.
+		 */
+		void reset(int numWeights);
+
+		/**
+		 * @fn	void Optimizer::nextStep();
+		 *
+		 * @brief	Starts the next update of all weights (Adam uses the number of steps for its bias
+		 * 			correction). Call it once before the apply() calls of each update.
+		 */
+		void nextStep();
+
+		/**
+		 * @fn	void Optimizer::apply(double *weights, const double *gradients, int offset, int count);
+		 *
+		 * @brief	Updates a range of the weights. The state is resized to fit if needed.
+		 *
+		 * @param [in,out]	weights  	The weights of the range.
+		 * @param 		  	gradients	The gradients of the range.
+		 * @param 		  	offset   	Index of the first weight of the range among all weights.
+		 * @param 		  	count	 	Number of weights in the range.
+		 */
+		void apply(double *weights, const double *gradients, int offset, int count);
+
+		/**
+		 * @fn	void Optimizer::apply(std::vector<double> &weights, const std::vector<double> &gradients);
+		 *
+		 * @brief	Runs a whole step (nextStep() and apply()) on a flat weight vector.
+		 *
+		 * @param [in,out]	weights  	The weights.
+		 * @param 		  	gradients	The gradients.
+		 */
+		void apply(std::vector<double> &weights, const std::vector<double> &gradients);
+
+		/**
+		 * @fn	OptimizerType Optimizer::getType() const;
+		 *
+		 * @brief	Gets the update rule.
+		 *
+		 * @return	The update rule.
+		 */
+		OptimizerType getType() const;
+
+		/**
+		 * @fn	int Optimizer::getStep() const;
+		 *
+		 * @brief	Gets the number of steps taken.
+		 *
+		 * @return	The number of steps.
+		 */
+		int getStep() const;
+
+		/**
+		 * @fn	std::string Optimizer::toString() const;
+		 *
+		 * @brief	Describes the update rule and its settings.
+		 *
+		 * @return	The description.
+		 */
+		std::string toString() const;
+
+	private:
+		OptimizerType type;
+		double rate, momentumFactor, decayFactor, beta1Factor, beta2Factor, epsilonTerm;
+
+		/** @brief	Number of steps taken. */
+		int step;
+
+		/** @brief	Corrections of Adam's running averages for the current step. */
+		double correction1, correction2;
+
+		/** @brief	Velocity (Momentum), running average of the squared gradients (RMSProp) or of the gradients (Adam). */
+		std::vector<double> first;
+
+		/** @brief	Running average of the squared gradients (Adam). */
+		std::vector<double> second;
+	};
+}
+
+#endif
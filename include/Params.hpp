@@ -6,6 +6,8 @@
 #ifndef PARAMS_H
 #define PARAMS_H
 
+#include <vector>
+#include "Activation.hpp"
 #include "NeuralNetConfiguration.hpp"
 
 namespace etunn
@@ -23,12 +25,21 @@ namespace etunn
 		/** @brief	Number of neurons per hidden layer */
 		static int neuronsPerHiddenLayer;
 
+		/** @brief	Number of neurons of each hidden layer */
+		static std::vector<int> hiddenLayerSizes;
+
+		/** @brief	Activation function of each layer including the output layer */
+		static std::vector<Activation> layerActivations;
+
 		/** @brief	Number of outputs */
 		static int numOutputs;
 
 		/** @brief	For tweeking the sigmoid function. */
 		static double activationResponse;
 
+		/** @brief	How exactly the sigmoid curve and tanh are calculated. */
+		static MathAccuracy mathAccuracy;
+
 		/** @brief	Bias value. */
 		static double bias;
 
@@ -47,6 +58,15 @@ namespace etunn
 		/** @brief	Number of copies of the elites */
 		static int numCopiesElite;
 
+		/** @brief	Maximum compatibility distance within a species (NEAT only) */
+		static double compatibilityThreshold;
+
+		/** @brief	Probability of adding a node (NEAT only) */
+		static double addNodeRate;
+
+		/** @brief	Probability of adding a connection (NEAT only) */
+		static double addConnectionRate;
+
 		/**
 		 * @fn	void Params::setParams(NeuralNetConfiguration config);
 		 *
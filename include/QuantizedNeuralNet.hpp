@@ -0,0 +1,112 @@
+/**
+ * @file	QuantizedNeuralNet.hpp.
+ *
+ * @brief	Declares the int8 quantized neural net class.
+ */
+#ifndef QUANTIZEDNEURALNET_H
+#define QUANTIZEDNEURALNET_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Params.hpp"
+#include "Topology.hpp"
+
+namespace etunn
+{
+	/**
+	 * @class	QuantizedNeuralNet
+	 *
+	 * @brief	An inference-only copy of a trained or evolved network with 8 bit weights.
+	 * 			Each layer stores its weights as int8 with one scale per layer and reads its
+	 * 			inputs as uint8 with a scale and zero point calibrated from sample inputs.
+	 * 			The dot products run on integers and the activation function is a lookup table.
+	 * 			The bias and activation response are baked in when the net is built.
+	 */
+	class QuantizedNeuralNet
+	{
+	public:
+
+		/**
+		 * @fn	QuantizedNeuralNet::QuantizedNeuralNet(const Topology &topology, const std::vector<double> &weights, const std::vector<std::vector<double> > &samples, Params p);
+		 *
+		 * @brief	Quantizes a network. If the amount of weights does not match the topology, the net
+		 * 			is left empty: update() then returns an empty vector and getModelSize() 0.
+		 *
+		 * @param	topology	The topology of the network (NeuralNet::getTopology()).
+		 * @param	weights 	The weights of the network (NeuralNet::getWeights()).
+		 * @param	samples 	Representative inputs used to calibrate the value ranges of each layer.
+		 * @param	p			Variable arguments providing additional information.
+		 */
+		QuantizedNeuralNet(const Topology &topology, const std::vector<double> &weights,
+			const std::vector<std::vector<double> > &samples, Params p);
+
+		/**
+		 * @fn	std::vector<double> QuantizedNeuralNet::update(const std::vector<double> &inputs);
+		 *
+		 * @brief	Calculates the outputs from a set of inputs.
+		 *
+		 * @param	inputs	The inputs.
+		 *
+		 * @return	The output of the network, or an empty vector if the amount of inputs is wrong.
+		 */
+		std::vector<double> update(const std::vector<double> &inputs);
+
+		/**
+		 * @fn	int QuantizedNeuralNet::getModelSize() const;
+		 *
+		 * @brief	Gets the number of bytes used by the weights, per-neuron constants and lookup tables.
+		 *
+		 * @return	The size of the model in bytes.
+		 */
+		int getModelSize() const;
+
+	private:
+
+		/**
+		 * @struct	Layer
+		 *
+		 * @brief	A quantized layer.
+		 */
+		struct Layer
+		{
+			/** @brief	Number of inputs and the row length padded for the vector kernels. */
+			int numInputs, stride;
+
+			/** @brief	Number of neurons. */
+			int numNeurons;
+
+			/** @brief	The weights, one padded row per neuron. */
+			std::vector<std::int8_t> weights;
+
+			/** @brief	Sum of the quantized weights of each neuron (to remove the input zero point). */
+			std::vector<std::int32_t> rowSums;
+
+			/** @brief	Bias weight times bias of each neuron. */
+			std::vector<float> biasTerms;
+
+			/** @brief	Scale of the weights. */
+			double weightScale;
+
+			/** @brief	Scale and zero point of the inputs. */
+			double inputScale;
+			int inputZero;
+
+			/** @brief	Range of the activation covered by the lookup table. */
+			double tableMin, tableStep;
+
+			/** @brief	Activation lookup table producing the quantized inputs of the next layer. */
+			std::vector<std::uint8_t> table;
+
+			/** @brief	Activation lookup table producing the outputs (last layer only). */
+			std::vector<float> outputTable;
+		};
+
+		std::vector<Layer> layers;
+
+		/** @brief	Quantized values passed between the layers. */
+		std::vector<std::uint8_t> bufferA, bufferB;
+	};
+}
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file	Simd.hpp.
+ *
+ * @brief	Declares a thin wrapper around the vector instructions used by the library's kernels.
+ * 			Internal, only included from source files and not installed.
+ */
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace etunn
+{
+	namespace simd
+	{
+		//A few doubles handled at once, so every kernel is written once for all instruction sets.
+		//exponent(t) builds 2^n from t = n + 1.5 * 2^52, which holds n in the low bits of the mantissa
+#if defined(__AVX__)
+		typedef __m256d Pack;
+		const int packSize = 4;
+
+		inline Pack load(const double *p) { return _mm256_loadu_pd(p); }
+		inline void store(double *p, Pack a) { _mm256_storeu_pd(p, a); }
+		inline Pack broadcast(double a) { return _mm256_set1_pd(a); }
+		inline Pack add(Pack a, Pack b) { return _mm256_add_pd(a, b); }
+		inline Pack sub(Pack a, Pack b) { return _mm256_sub_pd(a, b); }
+		inline Pack mul(Pack a, Pack b) { return _mm256_mul_pd(a, b); }
+		inline Pack divide(Pack a, Pack b) { return _mm256_div_pd(a, b); }
+		inline Pack root(Pack a) { return _mm256_sqrt_pd(a); }
+		inline Pack minimum(Pack a, Pack b) { return _mm256_min_pd(a, b); }
+		inline Pack maximum(Pack a, Pack b) { return _mm256_max_pd(a, b); }
+
+		inline Pack exponent(Pack t)
+		{
+#if defined(__AVX2__)
+			__m256i bits = _mm256_add_epi64(_mm256_castpd_si256(t), _mm256_set1_epi64x(1023));
+			return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+#else
+			//AVX has no 64 bit integer arithmetic, so work on the two halves
+			__m256i bits = _mm256_castpd_si256(t);
+			__m128i low = _mm_add_epi64(_mm256_castsi256_si128(bits), _mm_set1_epi64x(1023));
+			__m128i high = _mm_add_epi64(_mm256_extractf128_si256(bits, 1), _mm_set1_epi64x(1023));
+			bits = _mm256_insertf128_si256(_mm256_castsi128_si256(_mm_slli_epi64(low, 52)), _mm_slli_epi64(high, 52), 1);
+			return _mm256_castsi256_pd(bits);
+#endif
+		}
+#elif defined(__SSE2__)
+		typedef __m128d Pack;
+		const int packSize = 2;
+
+		inline Pack load(const double *p) { return _mm_loadu_pd(p); }
+		inline void store(double *p, Pack a) { _mm_storeu_pd(p, a); }
+		inline Pack broadcast(double a) { return _mm_set1_pd(a); }
+		inline Pack add(Pack a, Pack b) { return _mm_add_pd(a, b); }
+		inline Pack sub(Pack a, Pack b) { return _mm_sub_pd(a, b); }
+		inline Pack mul(Pack a, Pack b) { return _mm_mul_pd(a, b); }
+		inline Pack divide(Pack a, Pack b) { return _mm_div_pd(a, b); }
+		inline Pack root(Pack a) { return _mm_sqrt_pd(a); }
+		inline Pack minimum(Pack a, Pack b) { return _mm_min_pd(a, b); }
+		inline Pack maximum(Pack a, Pack b) { return _mm_max_pd(a, b); }
+
+		inline Pack exponent(Pack t)
+		{
+			__m128i bits = _mm_add_epi64(_mm_castpd_si128(t), _mm_set1_epi64x(1023));
+			return _mm_castsi128_pd(_mm_slli_epi64(bits, 52));
+		}
+#else
+		typedef double Pack;
+		const int packSize = 1;
+
+		inline Pack load(const double *p) { return *p; }
+		inline void store(double *p, Pack a) { *p = a; }
+		inline Pack broadcast(double a) { return a; }
+		inline Pack add(Pack a, Pack b) { return a + b; }
+		inline Pack sub(Pack a, Pack b) { return a - b; }
+		inline Pack mul(Pack a, Pack b) { return a * b; }
+		inline Pack divide(Pack a, Pack b) { return a / b; }
+		inline Pack root(Pack a) { return std::sqrt(a); }
+
+		//Like the instructions: the second operand is returned if either one is NaN
+		inline Pack minimum(Pack a, Pack b) { return a < b ? a : b; }
+		inline Pack maximum(Pack a, Pack b) { return a > b ? a : b; }
+
+		inline Pack exponent(Pack t)
+		{
+			std::uint64_t bits;
+			std::memcpy(&bits, &t, sizeof(bits));
+			bits = (bits + 1023) << 52;
+
+			double scale;
+			std::memcpy(&scale, &bits, sizeof(scale));
+
+			return scale;
+		}
+#endif
+	}
+}
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file	Topology.hpp.
+ *
+ * @brief	Declares the topology struct.
+ */
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <vector>
+#include "Activation.hpp"
+
+namespace etunn
+{
+	/**
+	 * @struct	Topology
+	 *
+	 * @brief	The shape of a network: the size and activation function of every layer.
+	 * 			Weights are laid out layer by layer and neuron by neuron, each neuron
+	 * 			storing one weight per input followed by its bias weight.
+	 */
+	struct Topology
+	{
+		/** @brief	Number of inputs. */
+		int numInputs;
+
+		/** @brief	Number of neurons in each layer, including the output layer. */
+		std::vector<int> layerSizes;
+
+		/** @brief	The activation function of each layer. */
+		std::vector<Activation> activations;
+
+		/** @brief	How exactly the activation functions are calculated. */
+		MathAccuracy accuracy;
+
+		/**
+		 * @fn	Topology()
+		 *
+		 * @brief	Default constructor.
+		 */
+		Topology() : numInputs(0), accuracy(MathAccuracy::Exact) {}
+
+		/**
+		 * @fn	int getLayerInputs(int layer) const
+		 *
+		 * @brief	Gets the number of inputs of a layer (without the bias).
+		 *
+		 * @param	layer	The layer.
+		 *
+		 * @return	The number of inputs.
+		 */
+		int getLayerInputs(int layer) const
+		{
+			return layer == 0 ? numInputs : layerSizes[layer - 1];
+		}
+
+		/**
+		 * @fn	int getNumberOfWeights() const
+		 *
+		 * @brief	Returns the total number of weights (including biases).
+		 *
+		 * @return	The number of weights.
+		 */
+		int getNumberOfWeights() const
+		{
+			int weights = 0;
+
+			for (int i = 0; i < (int)layerSizes.size(); ++i)
+			{
+				weights += layerSizes[i] * (getLayerInputs(i) + 1);
+			}
+
+			return weights;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file	Workspace.hpp.
+ *
+ * @brief	Declares the scratch space of the const inference of the neural nets.
+ */
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <vector>
+
+namespace etunn
+{
+	/**
+	 * @struct	Workspace
+	 *
+	 * @brief	Scratch space holding the outputs of the hidden layers during NeuralNet::update().
+	 * 			Keeping it outside of the net makes update() const, so one net can serve any number
+	 * 			of threads as long as each thread uses its own workspace. Create it with
+	 * 			NeuralNet::createWorkspace() to avoid allocations on the first call.
+	 */
+	struct Workspace
+	{
+		/** @brief	Outputs of the even and odd hidden layers. */
+		std::vector<double> layerA, layerB;
+	};
+}
+
+#endif
@@ -31,7 +31,13 @@
 #ifndef ETUNN_H
 #define ETUNN_H
 
-#include "evolutionary\NeuralNet.hpp"
-#include "feedforward\NeuralNet.hpp"
+#include "Dataset.hpp"
+#include "evolutionary/NeuralNet.hpp"
+#include "evolutionary/StaticNeuralNet.hpp"
+#include "feedforward/NeuralNet.hpp"
+#include "lstm/NeuralNet.hpp"
+#include "neat/NeatAlgorithm.hpp"
+#include "Optimizer.hpp"
+#include "QuantizedNeuralNet.hpp"
 
 #endif
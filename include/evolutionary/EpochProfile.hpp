@@ -0,0 +1,111 @@
+/**
+ * @file	evolutionary\EpochProfile.hpp.
+ *
+ * @brief	Declares the per-generation profile of the genetic algorithm.
+ */
+#ifndef EPOCHPROFILE_H
+#define EPOCHPROFILE_H
+
+#include <string>
+#include <vector>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @enum	EpochPhase
+		 *
+		 * @brief	The phases of a generation.
+		 */
+		enum class EpochPhase
+		{
+			/** @brief	Copying the population in and out and storing the offspring. */
+			Copy,
+
+			/** @brief	Sorting the population by fitness. */
+			Sort,
+
+			/** @brief	Calculating the best, worst, average and total fitness. */
+			Statistics,
+
+			/** @brief	Elitism and roulette wheel selection. */
+			Selection,
+
+			/** @brief	Crossover of the parents. */
+			Crossover,
+
+			/** @brief	Mutation of the offspring. */
+			Mutation
+		};
+
+		/** @brief	Number of phases of a generation. */
+		const int numEpochPhases = 6;
+
+		/**
+		 * @struct	EpochProfile
+		 *
+		 * @brief	Time and heap allocations spent in each phase of one generation.
+		 */
+		struct EpochProfile
+		{
+			/** @brief	The generation. */
+			int generation;
+
+			/** @brief	Seconds spent in each phase. */
+			double seconds[numEpochPhases];
+
+			/** @brief	Heap allocations made in each phase (zero without an allocation counter). */
+			long long allocations[numEpochPhases];
+
+			/**
+			 * @fn	EpochProfile()
+			 *
+			 * @brief	Default constructor.
+			 */
+			EpochProfile() : generation(0)
+			{
+				for (int i = 0; i < numEpochPhases; ++i)
+				{
+					seconds[i] = 0;
+					allocations[i] = 0;
+				}
+			}
+		};
+
+		/**
+		 * @fn	const char* epochPhaseName(EpochPhase phase);
+		 *
+		 * @brief	Gets the name of a phase.
+		 *
+		 * @param	phase	The phase.
+		 *
+		 * @return	The name.
+		 */
+		const char* epochPhaseName(EpochPhase phase);
+
+		/**
+		 * @fn	std::string profilesToCSV(const std::vector<EpochProfile> &profiles);
+		 *
+		 * @brief	Formats profiles as CSV, one row per generation.
+		 *
+		 * @param	profiles	The profiles.
+		 *
+		 * @return	The CSV text.
+		 */
+		std::string profilesToCSV(const std::vector<EpochProfile> &profiles);
+
+		/**
+		 * @fn	std::string profilesToJSON(const std::vector<EpochProfile> &profiles);
+		 *
+		 * @brief	Formats profiles as a JSON array, one object per generation.
+		 *
+		 * @param	profiles	The profiles.
+		 *
+		 * @return	The JSON text.
+		 */
+		std::string profilesToJSON(const std::vector<EpochProfile> &profiles);
+	}
+}
+
+#endif
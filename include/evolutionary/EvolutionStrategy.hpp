@@ -0,0 +1,198 @@
+/**
+ * @file	evolutionary\EvolutionStrategy.hpp.
+ *
+ * @brief	Declares the evolution strategy class.
+ */
+#ifndef EVOLUTIONSTRATEGY_H
+#define EVOLUTIONSTRATEGY_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "../Optimizer.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @class	EvolutionStrategy
+		 *
+		 * @brief	An evolution strategy in the style of OpenAI-ES, working on the flat weight vector of
+		 * 			a net (getWeights()/putWeights()). Every generation samples pairs of antithetic
+		 * 			candidates, center + sigma * noise and center - sigma * noise, with the noise of each
+		 * 			pair regenerated from a 64 bit seed. The fitnesses are replaced by their centered ranks
+		 * 			and the resulting gradient estimate is handed to an Optimizer, which moves the center.
+		 *
+		 * 			Since a candidate is fully described by the center and its seed, workers only have
+		 * 			to exchange seeds and fitnesses, never weight vectors. epoch() evaluates the candidates
+		 * 			on several threads itself; getSeeds(), getCandidate() and tell() allow evaluating
+		 * 			them anywhere else (e.g. on other machines).
+		 */
+		class EvolutionStrategy
+		{
+		public:
+
+			/**
+			 * @typedef	std::function<double(const std::vector<double> &weights, int thread)> FitnessFunction
+			 *
+			 * @brief	Returns the fitness (higher is better) of a candidate. Called from several threads
+			 * 			at once by epoch(), the thread index (0 to numThreads - 1) allows keeping one net per
+			 * 			thread.
+			 */
+			typedef std::function<double(const std::vector<double> &weights, int thread)> FitnessFunction;
+
+			/**
+			 * @fn	EvolutionStrategy::EvolutionStrategy(const std::vector<double> &weights, int numPairs, double sigma, const Optimizer &optimizer);
+			 *
+			 * @brief	Constructor. The seeds are drawn from rand(), so srand() makes a run repeatable.
+			 *
+			 * @param	weights  	The initial center, e.g. the weights of a freshly created net.
+			 * @param	numPairs 	Number of antithetic pairs per generation (the population is twice as large).
+			 * @param	sigma	 	Standard deviation of the noise.
+			 * @param	optimizer	Moves the center along the gradient estimate (e.g. Adam with a rate of 0.01).
+			 */
+			EvolutionStrategy(const std::vector<double> &weights, int numPairs, double sigma, const Optimizer &optimizer);
+
+			/**
+			 * @fn	void EvolutionStrategy::epoch(const FitnessFunction &fitness, int numThreads = 0);
+			 *
+			 * @brief	Runs one generation: evaluates all candidates on numThreads threads, then calls tell().
+			 *
+			 * @param	fitness   	The fitness function, safe to call from numThreads threads at once.
+			 * @param	numThreads	Number of threads (0 for one per core).
+			 */
+			void epoch(const FitnessFunction &fitness, int numThreads = 0);
+
+			/*Distributed evaluation: evaluate getCandidate(i) for every i below getPopulationSize() and pass the fitnesses to tell()*/
+
+			/**
+			 * @fn	const std::vector<std::uint64_t>& EvolutionStrategy::getSeeds() const;
+			 *
+			 * @brief	Gets the noise seed of each pair of the current generation.
+			 *
+			 * @return	The seeds.
+			 */
+			const std::vector<std::uint64_t>& getSeeds() const;
+
+			/**
+			 * @fn	void EvolutionStrategy::getCandidate(int index, std::vector<double> &weights) const;
+			 *
+			 * @brief	Gets a candidate of the current generation. Candidate 2 * i adds the noise of pair i
+			 * 			to the center, candidate 2 * i + 1 subtracts it.
+			 *
+			 * @param 		  	index  	Index of the candidate.
+			 * @param [in,out]	weights	Receives the weights of the candidate.
+			 */
+			void getCandidate(int index, std::vector<double> &weights) const;
+
+			/**
+			 * @fn	void EvolutionStrategy::tell(const std::vector<double> &fitnesses, int numThreads = 1);
+			 *
+			 * @brief	Moves the center using the fitnesses of all candidates of the current generation
+			 * 			and draws the seeds of the next one. Ignored if the amount of fitnesses is wrong.
+			 * 			A NaN fitness counts as -infinity, i.e. as the worst candidate.
+			 *
+			 * @param	fitnesses 	The fitness of each candidate, in the order of getCandidate().
+			 * @param	numThreads	Number of threads regenerating the noise (0 for one per core).
+			 */
+			void tell(const std::vector<double> &fitnesses, int numThreads = 1);
+
+			/**
+			 * @fn	static void EvolutionStrategy::generateNoise(std::uint64_t seed, double *noise, int count);
+			 *
+			 * @brief	Regenerates the standard normal noise of a seed.
+			 *
+			 * @param 		  	seed 	The seed.
+			 * @param [in,out]	noise	Receives the noise.
+			 * @param 		  	count	Number of values.
+			 */
+			static void generateNoise(std::uint64_t seed, double *noise, int count);
+
+			/*Accessor methods*/
+
+			/**
+			 * @fn	const std::vector<double>& EvolutionStrategy::getWeights() const;
+			 *
+			 * @brief	Gets the center of the search distribution, the current best guess for the weights.
+			 *
+			 * @return	The weights.
+			 */
+			const std::vector<double>& getWeights() const;
+
+			/**
+			 * @fn	int EvolutionStrategy::getPopulationSize() const;
+			 *
+			 * @brief	Gets the number of candidates per generation.
+			 *
+			 * @return	The population size.
+			 */
+			int getPopulationSize() const;
+
+			/**
+			 * @fn	int EvolutionStrategy::getGeneration() const;
+			 *
+			 * @brief	Gets the number of generations so far.
+			 *
+			 * @return	The generation.
+			 */
+			int getGeneration() const;
+
+			/**
+			 * @fn	double EvolutionStrategy::getAverageFitness() const;
+			 *
+			 * @brief	Gets the average fitness of the last generation.
+			 *
+			 * @return	The average fitness.
+			 */
+			double getAverageFitness() const;
+
+			/**
+			 * @fn	double EvolutionStrategy::getBestFitness() const;
+			 *
+			 * @brief	Gets the best fitness of the last generation.
+			 *
+			 * @return	The best fitness.
+			 */
+			double getBestFitness() const;
+
+			/**
+			 * @fn	const std::vector<double>& EvolutionStrategy::getBestWeights() const;
+			 *
+			 * @brief	Gets the best candidate of the last generation.
+			 *
+			 * @return	The weights.
+			 */
+			const std::vector<double>& getBestWeights() const;
+
+		private:
+			//Center of the search distribution
+			std::vector<double> center;
+
+			int numPairs;
+
+			double sigma;
+
+			Optimizer optimizer;
+
+			//Seeds of the current generation and the state the next ones are drawn from
+			std::vector<std::uint64_t> seeds;
+			std::uint64_t seedState;
+
+			int generation;
+
+			double averageFitness;
+
+			double bestFitness;
+
+			std::vector<double> bestWeights;
+
+			//Gradient estimate, summed over the threads of tell()
+			std::vector<double> gradient;
+
+			void drawSeeds();
+		};
+	}
+}
+
+#endif
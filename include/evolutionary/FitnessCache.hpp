@@ -0,0 +1,107 @@
+/**
+ * @file	evolutionary\FitnessCache.hpp.
+ *
+ * @brief	Declares the fitness cache class.
+ */
+#ifndef FITNESSCACHE_H
+#define FITNESSCACHE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Genome.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @class	FitnessCache
+		 *
+		 * @brief	Remembers the fitness of the last evaluated generation, keyed by a hash of the weights,
+		 * 			so that elites and unchanged offspring need not be evaluated again.
+		 * 			Only valid for deterministic fitness functions.
+		 */
+		class FitnessCache
+		{
+		public:
+
+			/**
+			 * @fn	FitnessCache::FitnessCache();
+			 *
+			 * @brief	Default constructor.
+			 */
+			FitnessCache();
+
+			/**
+			 * @fn	void FitnessCache::store(std::vector<Genome> &genomes);
+			 *
+			 * @brief	Replaces the cached generation with evaluated genomes. The genomes are
+			 * 			swapped in rather than copied, leaving the vector with the previous generation.
+			 *
+			 * @param [in,out]	genomes	The evaluated genomes.
+			 */
+			void store(std::vector<Genome> &genomes);
+
+			/**
+			 * @fn	bool FitnessCache::lookup(const std::vector<double> &weights, double &fitness);
+			 *
+			 * @brief	Looks up the fitness of a set of weights. A hit requires the weights to be
+			 * 			identical, not just to share the hash.
+			 *
+			 * @param 		  	weights	The weights.
+			 * @param [in,out]	fitness	Set to the cached fitness on a hit.
+			 *
+			 * @return	True on a hit.
+			 */
+			bool lookup(const std::vector<double> &weights, double &fitness);
+
+			/**
+			 * @fn	void FitnessCache::clear();
+			 *
+			 * @brief	Empties the cache and resets the hit and miss counters.
+			 */
+			void clear();
+
+			/**
+			 * @fn	long long FitnessCache::getHits() const;
+			 *
+			 * @brief	Gets the number of successful lookups.
+			 *
+			 * @return	The hits.
+			 */
+			long long getHits() const;
+
+			/**
+			 * @fn	long long FitnessCache::getMisses() const;
+			 *
+			 * @brief	Gets the number of failed lookups.
+			 *
+			 * @return	The misses.
+			 */
+			long long getMisses() const;
+
+			/**
+			 * @fn	static std::uint64_t FitnessCache::hashWeights(const std::vector<double> &weights);
+			 *
+			 * @brief	Hashes the bit patterns of a set of weights.
+			 *
+			 * @param	weights	The weights.
+			 *
+			 * @return	The hash.
+			 */
+			static std::uint64_t hashWeights(const std::vector<double> &weights);
+
+		private:
+			/** @brief	The cached generation. */
+			std::vector<Genome> genomes;
+
+			/** @brief	Index into genomes by hash of the weights. */
+			std::unordered_map<std::uint64_t, int> index;
+
+			long long hits, misses;
+		};
+	}
+}
+
+#endif
@@ -6,9 +6,15 @@
 #ifndef GENETICALGORITHM_H
 #define GENETICALGORITHM_H
 
+#include <chrono>
+#include <functional>
 #include <vector>
 #include "../Params.hpp"
+#include "EpochProfile.hpp"
+#include "FitnessCache.hpp"
 #include "Genome.hpp"
+#include "Mutation.hpp"
+#include "StoppingCriteria.hpp"
 
 namespace etunn
 {
@@ -23,6 +29,13 @@ namespace etunn
 		{
 		public:
 
+			/**
+			 * @typedef	std::function<double(const std::vector<double> &weights)> FitnessFunction
+			 *
+			 * @brief	Returns the fitness (higher is better) of a set of weights.
+			 */
+			typedef std::function<double(const std::vector<double> &weights)> FitnessFunction;
+
 			/**
 			 * @fn	GeneticAlgorithm::GeneticAlgorithm(int popSize, double mutRat, double crossRat, int numWeights);
 			 *
@@ -47,6 +60,21 @@ namespace etunn
 			 */
 			std::vector<Genome> epoch(std::vector<Genome> &old_pop, Params p);
 
+			/**
+			 * @fn	StopReason GeneticAlgorithm::run(const FitnessFunction &fitness, const StoppingCriteria &criteria, Params p);
+			 *
+			 * @brief	Evaluates the population and runs epoch() until one of the stopping criteria is met,
+			 * 			continuing from the current population. Uses the fitness cache if it is on.
+			 * 			The best genome found is available from getBestGenome() afterwards.
+			 *
+			 * @param	fitness 	The fitness function.
+			 * @param	criteria	When to stop. With every criterion off, run() never returns.
+			 * @param	p			Variable arguments providing additional information.
+			 *
+			 * @return	The criterion that stopped the run.
+			 */
+			StopReason run(const FitnessFunction &fitness, const StoppingCriteria &criteria, Params p);
+
 			/*Accessor methods*/
 
 			/**
@@ -76,6 +104,140 @@ namespace etunn
 			 */
 			double getBestFitness() const;
 
+			/**
+			 * @fn	const Genome& GeneticAlgorithm::getBestGenome() const;
+			 *
+			 * @brief	Gets the best genome evaluated by run().
+			 *
+			 * @return	The best genome.
+			 */
+			const Genome& getBestGenome() const;
+
+			/**
+			 * @fn	int GeneticAlgorithm::getGeneration() const;
+			 *
+			 * @brief	Gets the number of epochs run so far.
+			 *
+			 * @return	The generation.
+			 */
+			int getGeneration() const;
+
+			/*Profiling*/
+
+			/**
+			 * @fn	void GeneticAlgorithm::enableProfiling(bool enable, long long (*allocationCounter)() = nullptr);
+			 *
+			 * @brief	Turns the recording of an EpochProfile for every following epoch on or off.
+			 * 			Profiling is off by default and costs only a branch per phase while off.
+			 *
+			 * @param	enable			 	True to record profiles.
+			 * @param	allocationCounter	Optional function returning the number of heap allocations
+			 * 								made so far (e.g. from a replaced operator new). Without it
+			 * 								the allocation counts stay zero.
+			 */
+			void enableProfiling(bool enable, long long (*allocationCounter)() = nullptr);
+
+			/**
+			 * @fn	const std::vector<EpochProfile>& GeneticAlgorithm::getProfiles() const;
+			 *
+			 * @brief	Gets the profiles recorded so far, one per epoch.
+			 *
+			 * @return	The profiles.
+			 */
+			const std::vector<EpochProfile>& getProfiles() const;
+
+			/**
+			 * @fn	void GeneticAlgorithm::clearProfiles();
+			 *
+			 * @brief	Discards the recorded profiles.
+			 */
+			void clearProfiles();
+
+			/*Fitness cache*/
+
+			/**
+			 * @fn	void GeneticAlgorithm::enableFitnessCache(bool enable);
+			 *
+			 * @brief	Turns the fitness cache on or off. While on, every epoch keeps the evaluated
+			 * 			population it was given, so that the caller can skip evaluating offspring
+			 * 			identical to a parent (elites and pairs that were not crossed over or mutated).
+			 * 			Only use with deterministic fitness functions.
+			 *
+			 * @param	enable	True to cache.
+			 */
+			void enableFitnessCache(bool enable);
+
+			/**
+			 * @fn	bool GeneticAlgorithm::getCachedFitness(const std::vector<double> &weights, double &fitness);
+			 *
+			 * @brief	Looks up the fitness of weights evaluated in the previous generation.
+			 *
+			 * @param 		  	weights	The weights.
+			 * @param [in,out]	fitness	Set to the cached fitness on a hit.
+			 *
+			 * @return	True on a hit, false on a miss or if the cache is off.
+			 */
+			bool getCachedFitness(const std::vector<double> &weights, double &fitness);
+
+			/**
+			 * @fn	const FitnessCache& GeneticAlgorithm::getFitnessCache() const;
+			 *
+			 * @brief	Gets the fitness cache (e.g. for its hit and miss counts).
+			 *
+			 * @return	The fitness cache.
+			 */
+			const FitnessCache& getFitnessCache() const;
+
+			/*Mutation adaptation*/
+
+			/**
+			 * @fn	void GeneticAlgorithm::setMutationAdaptation(MutationAdaptation adaptation);
+			 *
+			 * @brief	Sets how the strength of the mutation adapts during the run (Default: None).
+			 * 			The 1/5th rule compares the offspring with their parents, so the population has
+			 * 			to be passed to epoch() in the order the previous epoch() returned it.
+			 *
+			 * @param	adaptation	The adaptation.
+			 */
+			void setMutationAdaptation(MutationAdaptation adaptation);
+
+			/**
+			 * @fn	void GeneticAlgorithm::setMutationSchedule(const MutationSchedule &schedule);
+			 *
+			 * @brief	Sets a schedule changing the mutation rate and perturbation scale every generation,
+			 * 			e.g. decaySchedule() or stagnationSchedule(). Runs after the adaptation.
+			 *
+			 * @param	schedule	The schedule, or an empty one for none.
+			 */
+			void setMutationSchedule(const MutationSchedule &schedule);
+
+			/**
+			 * @fn	double GeneticAlgorithm::getMutationRate() const;
+			 *
+			 * @brief	Gets the current mutation rate.
+			 *
+			 * @return	The mutation rate.
+			 */
+			double getMutationRate() const;
+
+			/**
+			 * @fn	double GeneticAlgorithm::getPerturbationScale() const;
+			 *
+			 * @brief	Gets the current factor on Params::maxPerturbation.
+			 *
+			 * @return	The perturbation scale.
+			 */
+			double getPerturbationScale() const;
+
+			/**
+			 * @fn	const FitnessStats& GeneticAlgorithm::getFitnessStats() const;
+			 *
+			 * @brief	Gets the fitness statistics of the last epoch.
+			 *
+			 * @return	The statistics.
+			 */
+			const FitnessStats& getFitnessStats() const;
+
 		private:
 			/** @brief	Entire population of chromosomes. */
 			std::vector<Genome> population;
@@ -113,6 +275,54 @@ namespace etunn
 			/** @brief	Generation counter. */
 			int generation;
 
+			/** @brief	True if epochs are profiled. */
+			bool profiling;
+
+			/** @brief	Returns the number of heap allocations so far, or nullptr. */
+			long long (*allocationCounter)();
+
+			/** @brief	The recorded profiles. */
+			std::vector<EpochProfile> profiles;
+
+			/** @brief	The profile of the running epoch. */
+			EpochProfile currentProfile;
+
+			/** @brief	Start of the running phase. */
+			std::chrono::steady_clock::time_point phaseStart;
+
+			/** @brief	Allocation count at the start of the running phase. */
+			long long phaseAllocations;
+
+			/** @brief	True if the fitness cache is used. */
+			bool caching;
+
+			/** @brief	Fitness of the previous generation. */
+			FitnessCache fitnessCache;
+
+			/** @brief	How the mutation adapts on its own. */
+			MutationAdaptation adaptation;
+
+			/** @brief	Changes the mutation every generation, may be empty. */
+			MutationSchedule schedule;
+
+			/** @brief	Factor on Params::maxPerturbation. */
+			double perturbationScale;
+
+			/** @brief	Statistics of the last epoch. */
+			FitnessStats stats;
+
+			/** @brief	Best fitness seen so far. */
+			double bestEverFitness;
+
+			/** @brief	Fitness of the better parent of each genome returned by the last epoch (NaN for elites). */
+			std::vector<double> parentFitness;
+
+			/** @brief	Per weight sums and sums of squares over the population, for the diversity. */
+			std::vector<double> weightSums, weightSquares;
+
+			/** @brief	The best genome evaluated by run(). */
+			Genome bestGenome;
+
 			/**
 			 * @fn	void GeneticAlgorithm::crossover(const std::vector<double> &mum, const std::vector<double> &dad, std::vector<double> &baby1, std::vector<double> &baby2);
 			 *
@@ -126,14 +336,38 @@ namespace etunn
 			void crossover(const std::vector<double> &mum, const std::vector<double> &dad, std::vector<double> &baby1, std::vector<double> &baby2);
 
 			/**
-			 * @fn	void GeneticAlgorithm::mutate(std::vector<double> &chromo, Params p);
+			 * @fn	void GeneticAlgorithm::mutate(std::vector<double> &chromo, double scale, Params p);
 			 *
-			 * @brief	Mutates two chromosomes.
+			 * @brief	Mutates a chromosome.
 			 *
 			 * @param [in,out]	chromo	The chromosome.
+			 * @param 		  	scale 	Factor on the maximum perturbation.
 			 * @param 		  	p	  	Variable arguments providing additional information.
 			 */
-			void mutate(std::vector<double> &chromo, Params p);
+			void mutate(std::vector<double> &chromo, double scale, Params p);
+
+			/**
+			 * @fn	void GeneticAlgorithm::measureSuccess();
+			 *
+			 * @brief	Calculates the fraction of the offspring of the last epoch that beat their better parent.
+			 */
+			void measureSuccess();
+
+			/**
+			 * @fn	void GeneticAlgorithm::adaptMutation();
+			 *
+			 * @brief	Updates the statistics and applies the adaptation and the schedule.
+			 */
+			void adaptMutation();
+
+			/**
+			 * @fn	double GeneticAlgorithm::randomGaussian();
+			 *
+			 * @brief	Returns a standard normal random number.
+			 *
+			 * @return	The random number.
+			 */
+			double randomGaussian();
 
 			/**
 			 * @fn	Genome GeneticAlgorithm::getChromoRoulette();
@@ -162,12 +396,35 @@ namespace etunn
 			 */
 			void calculateBestWorstAvTot();
 
+			/**
+			 * @fn	void GeneticAlgorithm::calculateDiversity();
+			 *
+			 * @brief	Calculates the spread of the weights and the fitness of the population.
+			 */
+			void calculateDiversity();
+
 			/**
 			 * @fn	void GeneticAlgorithm::reset();
 			 *
 			 * @brief	Resets this object.
 			 */
 			void reset();
+
+			/**
+			 * @fn	void GeneticAlgorithm::startPhase();
+			 *
+			 * @brief	Starts timing a phase if profiling is on.
+			 */
+			void startPhase();
+
+			/**
+			 * @fn	void GeneticAlgorithm::stopPhase(EpochPhase phase);
+			 *
+			 * @brief	Adds the time and allocations since the last start to a phase and starts the next one.
+			 *
+			 * @param	phase	The phase that just ended.
+			 */
+			void stopPhase(EpochPhase phase);
 		};
 	}
 }
@@ -25,12 +25,15 @@ namespace etunn
 			/** @brief	The fitness */
 			double fitness;
 
+			/** @brief	Factor on the perturbation of this genome's mutations (MutationAdaptation::SelfAdaptive only) */
+			double mutationScale;
+
 			/**
 			 * @fn	Genome()
 			 *
 			 * @brief	Default constructor.
 			 */
-			Genome() : fitness(0) {}
+			Genome() : fitness(0), mutationScale(1) {}
 
 			/**
 			 * @fn	Genome(std::vector<double> w, double f)
@@ -40,7 +43,7 @@ namespace etunn
 			 * @param	w	The weights.
 			 * @param	f	The fitness
 			 */
-			Genome(std::vector<double> w, double f) : weights(w), fitness(f) {}
+			Genome(std::vector<double> w, double f) : weights(w), fitness(f), mutationScale(1) {}
 
 			/**
 			 * @fn	friend bool operator< (const Genome& lhs, const Genome& rhs)
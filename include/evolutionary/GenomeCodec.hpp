@@ -0,0 +1,190 @@
+/**
+ * @file	evolutionary\GenomeCodec.hpp.
+ *
+ * @brief	Declares the genome codec class.
+ */
+#ifndef GENOMECODEC_H
+#define GENOMECODEC_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Genome.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @enum	WeightPrecision
+		 *
+		 * @brief	How the weights of encoded genomes are stored.
+		 */
+		enum class WeightPrecision
+		{
+			/** @brief	8 bytes per weight, lossless. */
+			Double,
+
+			/** @brief	4 bytes per weight, about 7 significant digits. */
+			Float,
+
+			/** @brief	2 bytes per weight (IEEE half precision), about 3 significant digits,
+			 * 			magnitudes up to 65504. */
+			Float16,
+
+			/** @brief	2 bytes per weight (the upper half of a float), about 2 significant digits,
+			 * 			but the full range of a float. */
+			BFloat16
+		};
+
+		/**
+		 * @class	GenomeCodec
+		 *
+		 * @brief	Encodes populations compactly for checkpoints and for sending them to other processes.
+		 * 			The weights are rounded to the chosen precision; fitness and mutation scale are kept exact.
+		 * 			The encoding is little-endian on every platform.
+		 *
+		 * 			A population can also be encoded as a delta against a reference population both sides
+		 * 			have, e.g. the previous generation. Every genome is then stored as a splice of up to two
+		 * 			reference genomes at one point (like the single-point crossover of GeneticAlgorithm) plus
+		 * 			the weights that differ, so elites and offspring with few mutations take only a few bytes.
+		 * 			Weights taken from the reference are copied exactly, only the differing ones are rounded.
+		 * 			When chaining deltas, use the decoded population as the next reference, as only that
+		 * 			is known to the receiver.
+		 */
+		class GenomeCodec
+		{
+		public:
+
+			/**
+			 * @fn	GenomeCodec::GenomeCodec(WeightPrecision precision = WeightPrecision::Float16);
+			 *
+			 * @brief	Constructor.
+			 *
+			 * @param	precision	The precision the weights are stored in.
+			 */
+			GenomeCodec(WeightPrecision precision = WeightPrecision::Float16);
+
+			/**
+			 * @fn	void GenomeCodec::encode(const std::vector<Genome> &population, std::vector<unsigned char> &bytes) const;
+			 *
+			 * @brief	Encodes a population on its own.
+			 *
+			 * @param 		  	population	The population.
+			 * @param [in,out]	bytes	  	Set to the encoded population.
+			 */
+			void encode(const std::vector<Genome> &population, std::vector<unsigned char> &bytes) const;
+
+			/**
+			 * @fn	void GenomeCodec::encode(const std::vector<Genome> &population, const std::vector<Genome> &reference, std::vector<unsigned char> &bytes) const;
+			 *
+			 * @brief	Encodes a population as a delta against a reference population. Genomes that share
+			 * 			too little with the reference are stored like by encode() above.
+			 *
+			 * @param 		  	population	The population.
+			 * @param 		  	reference 	The reference population, needed again for decoding.
+			 * @param [in,out]	bytes	  	Set to the encoded population.
+			 */
+			void encode(const std::vector<Genome> &population, const std::vector<Genome> &reference, std::vector<unsigned char> &bytes) const;
+
+			/**
+			 * @fn	static bool GenomeCodec::decode(const std::vector<unsigned char> &bytes, std::vector<Genome> &population);
+			 *
+			 * @brief	Decodes a population encoded without a reference. The precision is read from the bytes.
+			 *
+			 * @param 		  	bytes	  	The encoded population.
+			 * @param [in,out]	population	Set to the decoded population, empty on failure.
+			 *
+			 * @return	False if the bytes are malformed or were encoded against a reference.
+			 */
+			static bool decode(const std::vector<unsigned char> &bytes, std::vector<Genome> &population);
+
+			/**
+			 * @fn	static bool GenomeCodec::decode(const std::vector<unsigned char> &bytes, const std::vector<Genome> &reference, std::vector<Genome> &population);
+			 *
+			 * @brief	Decodes a population encoded with or without a reference.
+			 *
+			 * @param 		  	bytes	  	The encoded population.
+			 * @param 		  	reference 	The reference population used for encoding.
+			 * @param [in,out]	population	Set to the decoded population, empty on failure.
+			 *
+			 * @return	False if the bytes are malformed or the reference differs from the one used for
+			 * 			encoding (checked by a checksum).
+			 */
+			static bool decode(const std::vector<unsigned char> &bytes, const std::vector<Genome> &reference, std::vector<Genome> &population);
+
+			/**
+			 * @fn	static bool GenomeCodec::save(const std::string &path, const std::vector<unsigned char> &bytes);
+			 *
+			 * @brief	Writes an encoded population to a file.
+			 *
+			 * @param	path 	The path.
+			 * @param	bytes	The encoded population.
+			 *
+			 * @return	True on success.
+			 */
+			static bool save(const std::string &path, const std::vector<unsigned char> &bytes);
+
+			/**
+			 * @fn	static bool GenomeCodec::load(const std::string &path, std::vector<unsigned char> &bytes);
+			 *
+			 * @brief	Reads an encoded population from a file.
+			 *
+			 * @param 		  	path 	The path.
+			 * @param [in,out]	bytes	Set to the contents of the file.
+			 *
+			 * @return	True on success.
+			 */
+			static bool load(const std::string &path, std::vector<unsigned char> &bytes);
+
+			/**
+			 * @fn	static double GenomeCodec::round(WeightPrecision precision, double weight);
+			 *
+			 * @brief	Rounds a weight to a precision (to the nearest, ties to even), giving the value it
+			 * 			decodes to. Rounding a population in place keeps it in step with a receiver.
+			 *
+			 * @param	precision	The precision.
+			 * @param	weight   	The weight.
+			 *
+			 * @return	The rounded weight.
+			 */
+			static double round(WeightPrecision precision, double weight);
+
+			/**
+			 * @fn	WeightPrecision GenomeCodec::getPrecision() const;
+			 *
+			 * @brief	Gets the precision the weights are stored in.
+			 *
+			 * @return	The precision.
+			 */
+			WeightPrecision getPrecision() const;
+
+		private:
+			WeightPrecision precision;
+
+			/**
+			 * @fn	void GenomeCodec::writeHeader(std::vector<unsigned char> &bytes, int numGenomes, const std::vector<Genome> *reference) const;
+			 *
+			 * @brief	Starts the encoding with the format, the precision and the reference's size and checksum.
+			 */
+			void writeHeader(std::vector<unsigned char> &bytes, int numGenomes, const std::vector<Genome> *reference) const;
+
+			/**
+			 * @fn	void GenomeCodec::writeWeights(std::vector<unsigned char> &bytes, const Genome &genome) const;
+			 *
+			 * @brief	Appends a genome with all its weights.
+			 */
+			void writeWeights(std::vector<unsigned char> &bytes, const Genome &genome) const;
+
+			/**
+			 * @fn	static std::uint64_t GenomeCodec::checksum(const std::vector<Genome> &population);
+			 *
+			 * @brief	Hashes the weights of a population to recognize the reference when decoding.
+			 */
+			static std::uint64_t checksum(const std::vector<Genome> &population);
+		};
+	}
+}
+
+#endif
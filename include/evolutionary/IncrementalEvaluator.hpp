@@ -0,0 +1,115 @@
+/**
+ * @file	evolutionary\IncrementalEvaluator.hpp.
+ *
+ * @brief	Declares the incremental evaluator class.
+ */
+#ifndef INCREMENTALEVALUATOR_H
+#define INCREMENTALEVALUATOR_H
+
+#include <vector>
+
+#include "../Params.hpp"
+#include "../Topology.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @class	IncrementalEvaluator
+		 *
+		 * @brief	Evaluates a network on a fixed set of inputs, keeping the activations of every
+		 * 			layer of a parent so that a child differing in a few weights is evaluated by
+		 * 			propagating only the changes: a neuron is recomputed when one of its weights or
+		 * 			one of its inputs changed, and only the changed terms of its sum are added.
+		 * 			The saving is largest for shallow, wide nets; in a dense net a single changed
+		 * 			hidden activation reaches every neuron of the next layer.
+		 * 			Results match a full update() up to floating point rounding.
+		 */
+		class IncrementalEvaluator
+		{
+		public:
+
+			/**
+			 * @fn	IncrementalEvaluator::IncrementalEvaluator(const Topology &topology, const std::vector<std::vector<double> > &inputs, Params p);
+			 *
+			 * @brief	Constructor. Inputs of the wrong size are replaced by zeros.
+			 *
+			 * @param	topology	The topology of the network (NeuralNet::getTopology()).
+			 * @param	inputs  	The inputs the network is evaluated on.
+			 * @param	p			Variable arguments providing additional information.
+			 */
+			IncrementalEvaluator(const Topology &topology, const std::vector<std::vector<double> > &inputs, Params p);
+
+			/**
+			 * @fn	void IncrementalEvaluator::setParent(const std::vector<double> &weights);
+			 *
+			 * @brief	Fully evaluates the parent and keeps the activations of all its layers.
+			 *
+			 * @param	weights	The weights of the parent.
+			 */
+			void setParent(const std::vector<double> &weights);
+
+			/**
+			 * @fn	const std::vector<std::vector<double> >& IncrementalEvaluator::getParentOutputs() const;
+			 *
+			 * @brief	Gets the outputs of the parent, one vector per input.
+			 *
+			 * @return	The outputs.
+			 */
+			const std::vector<std::vector<double> >& getParentOutputs() const;
+
+			/**
+			 * @fn	void IncrementalEvaluator::evaluate(const std::vector<double> &weights, std::vector<std::vector<double> > &outputs);
+			 *
+			 * @brief	Evaluates a child of the parent. The parent stays unchanged.
+			 *
+			 * @param 		  	weights	The weights of the child.
+			 * @param [in,out]	outputs	Set to the outputs of the child, one vector per input.
+			 */
+			void evaluate(const std::vector<double> &weights, std::vector<std::vector<double> > &outputs);
+
+			/**
+			 * @fn	int IncrementalEvaluator::getNumberOfRecomputedNeurons() const;
+			 *
+			 * @brief	Gets the number of neurons the last evaluate() had to recompute, summed over the inputs.
+			 *
+			 * @return	The number of neurons.
+			 */
+			int getNumberOfRecomputedNeurons() const;
+
+		private:
+			Topology topology;
+			std::vector<std::vector<double> > inputs;
+			double bias, response;
+
+			/** @brief	Index of the first weight of each layer. */
+			std::vector<int> layerOffsets;
+
+			/** @brief	The weights of the parent. */
+			std::vector<double> parentWeights;
+
+			/** @brief	Net input and activation of each neuron of the parent, per input and layer. */
+			std::vector<std::vector<std::vector<double> > > parentSums, parentActivations;
+
+			/** @brief	Outputs of the parent, per input. */
+			std::vector<std::vector<double> > parentOutputs;
+
+			/** @brief	Changed weights (index within the neuron) of each neuron, per layer. */
+			std::vector<std::vector<std::vector<int> > > changedWeights;
+
+			/** @brief	Neurons with changed weights, per layer. */
+			std::vector<std::vector<int> > dirtyNeurons;
+
+			/** @brief	Neurons whose activation changed in the previous and the current layer. */
+			std::vector<int> changedInputs, changedOutputs;
+
+			/** @brief	Activation of the child, per layer (valid for changed neurons only). */
+			std::vector<std::vector<double> > childActivations;
+
+			int recomputed;
+		};
+	}
+}
+
+#endif
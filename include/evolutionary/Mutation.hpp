@@ -0,0 +1,110 @@
+/**
+ * @file	evolutionary\Mutation.hpp.
+ *
+ * @brief	Declares the mutation adaptation and schedules of the genetic algorithm.
+ */
+#ifndef MUTATION_H
+#define MUTATION_H
+
+#include <functional>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @enum	MutationAdaptation
+		 *
+		 * @brief	How the genetic algorithm adapts the strength of the mutation on its own.
+		 */
+		enum class MutationAdaptation
+		{
+			/** @brief	The perturbation only changes through a schedule. */
+			None,
+
+			/** @brief	Rechenberg's 1/5th success rule: the perturbation grows while more than a fifth of
+			 * 			the offspring beat their parents and shrinks while fewer do. */
+			OneFifthRule,
+
+			/** @brief	Log-normal self-adaptation: every genome carries its own mutation scale, which is
+			 * 			inherited and mutated along with the weights, so good step sizes are selected for. */
+			SelfAdaptive
+		};
+
+		/**
+		 * @struct	FitnessStats
+		 *
+		 * @brief	The fitness statistics of a generation, as seen by a mutation schedule.
+		 */
+		struct FitnessStats
+		{
+			/** @brief	The generation. */
+			int generation;
+
+			/** @brief	The best fitness. */
+			double bestFitness;
+
+			/** @brief	The average fitness. */
+			double averageFitness;
+
+			/** @brief	The worst fitness. */
+			double worstFitness;
+
+			/** @brief	Number of generations since the best fitness last improved. */
+			int stagnantGenerations;
+
+			/** @brief	Fraction of the offspring of the previous generation that beat their better parent. */
+			double successRate;
+
+			/** @brief	Root mean square over all weights of the standard deviation of that weight across the population. */
+			double diversity;
+
+			/** @brief	Standard deviation of the fitness across the population. */
+			double fitnessDeviation;
+
+			/**
+			 * @fn	FitnessStats()
+			 *
+			 * @brief	Default constructor.
+			 */
+			FitnessStats() : generation(0), bestFitness(0), averageFitness(0), worstFitness(0),
+				stagnantGenerations(0), successRate(0), diversity(0), fitnessDeviation(0) {}
+		};
+
+		/**
+		 * @typedef	std::function<void(const FitnessStats &stats, double &mutationRate, double &perturbationScale)> MutationSchedule
+		 *
+		 * @brief	Called once per generation after the fitness statistics are calculated. May change the
+		 * 			mutation rate and the scale applied to Params::maxPerturbation.
+		 */
+		typedef std::function<void(const FitnessStats &stats, double &mutationRate, double &perturbationScale)> MutationSchedule;
+
+		/**
+		 * @fn	MutationSchedule decaySchedule(double factor, double minScale);
+		 *
+		 * @brief	Multiplies the perturbation scale by a factor every generation, down to a minimum.
+		 *
+		 * @param	factor  	The factor (e.g. 0.99).
+		 * @param	minScale	The smallest scale.
+		 *
+		 * @return	The schedule.
+		 */
+		MutationSchedule decaySchedule(double factor, double minScale);
+
+		/**
+		 * @fn	MutationSchedule stagnationSchedule(int patience, double factor, double maxScale);
+		 *
+		 * @brief	Multiplies the perturbation scale by a factor whenever the best fitness has not improved
+		 * 			for a number of generations, to escape local optima, and resets it to 1 on improvement.
+		 *
+		 * @param	patience	Number of generations without improvement before each increase.
+		 * @param	factor  	The factor (e.g. 2).
+		 * @param	maxScale	The largest scale.
+		 *
+		 * @return	The schedule.
+		 */
+		MutationSchedule stagnationSchedule(int patience, double factor, double maxScale);
+	}
+}
+
+#endif
@@ -11,19 +11,17 @@
 #include <vector>
 
 #include "../NeuralNetConfiguration.hpp"
+#include "../InferenceStats.hpp"
+#include "../Kernels.hpp"
 #include "../Params.hpp"
 #include "../Neuron.hpp"
 #include "../NeuronLayer.hpp"
+#include "../Topology.hpp"
+#include "../Workspace.hpp"
+#include "EvolutionStrategy.hpp"
 #include "Genome.hpp"
 #include "GeneticAlgorithm.hpp"
 
-/**
- * @def	NUM_E
- *
- * @brief	A macro that defines the number e.
- */
-#define NUM_E 2.71828182846
-
 namespace etunn
 {
 	namespace evolutionary
@@ -78,6 +76,15 @@ namespace etunn
 			 */
 			int getNumberOfWeights() const;
 
+			/**
+			 * @fn	Topology NeuralNet::getTopology() const;
+			 *
+			 * @brief	Gets the size and activation function of every layer.
+			 *
+			 * @return	The topology.
+			 */
+			Topology getTopology() const;
+
 			/**
 			 * @fn	void NeuralNet::putWeights(std::vector<double> &weights);
 			 *
@@ -88,16 +95,102 @@ namespace etunn
 			void putWeights(std::vector<double> &weights);
 
 			/**
-			 * @fn	std::vector<double> NeuralNet::update(std::vector<double> &inputs, Params p);
+			 * @fn	int NeuralNet::prune(double threshold);
+			 *
+			 * @brief	Sets every weight whose magnitude is below the threshold to zero.
+			 *
+			 * @param	threshold	The threshold.
+			 *
+			 * @return	The number of weights that were pruned.
+			 */
+			int prune(double threshold);
+
+			/**
+			 * @fn	void NeuralNet::sparsify(double maxDensity);
 			 *
-			 * @brief	Calculates the outputs from a set of inputs.
+			 * @brief	Stores every layer whose share of non-zero weights is below maxDensity in
+			 * 			compressed rows (which skip the zero weights in update()), and every other layer densely.
+			 * 			putWeights() turns all layers dense again.
 			 *
-			 * @param [in,out]	inputs	The inputs.
-			 * @param 		  	p	  	Variable arguments providing additional information.
+			 * @param	maxDensity	The density below which a layer gets compressed.
+			 */
+			void sparsify(double maxDensity);
+
+			/**
+			 * @fn	int NeuralNet::getNumberOfNonZeroWeights() const;
+			 *
+			 * @brief	Returns the number of weights that are not zero.
+			 *
+			 * @return	The number of non-zero weights.
+			 */
+			int getNumberOfNonZeroWeights() const;
+
+			/**
+			 * @fn	std::vector<double> NeuralNet::update(const std::vector<double> &inputs, Params p) const;
+			 *
+			 * @brief	Calculates the outputs from a set of inputs. Safe to call from several threads at once.
+			 *
+			 * @param	inputs	The inputs.
+			 * @param	p	  	Variable arguments providing additional information.
 			 *
 			 * @return	The output of the network.
 			 */
-			std::vector<double> update(std::vector<double> &inputs, Params p);
+			std::vector<double> update(const std::vector<double> &inputs, Params p) const;
+
+			/**
+			 * @fn	std::vector<double> NeuralNet::update(const double *inputs, Params p) const;
+			 *
+			 * @brief	Calculates the outputs from inputs stored elsewhere (e.g. a row of a Batch),
+			 * 			without copying them into a vector. Safe to call from several threads at once.
+			 *
+			 * @param	inputs	The inputs, as many as the network has.
+			 * @param	p	  	Variable arguments providing additional information.
+			 *
+			 * @return	The output of the network.
+			 */
+			std::vector<double> update(const double *inputs, Params p) const;
+
+			/**
+			 * @fn	Workspace NeuralNet::createWorkspace() const;
+			 *
+			 * @brief	Creates scratch space large enough for update() with a workspace.
+			 *
+			 * @return	The workspace.
+			 */
+			Workspace createWorkspace() const;
+
+			/**
+			 * @fn	void NeuralNet::update(const double *inputs, double *outputs, Workspace &workspace, Params p) const;
+			 *
+			 * @brief	Calculates the outputs from a set of inputs without allocating (given a workspace
+			 * 			from createWorkspace()). Safe to call from several threads at once as long as each
+			 * 			uses its own workspace.
+			 *
+			 * @param 		  	inputs   	The inputs, as many as the network has.
+			 * @param [in,out]	outputs  	Receives the outputs, as many as the network has.
+			 * @param [in,out]	workspace	The scratch space.
+			 * @param 		  	p		 	Variable arguments providing additional information.
+			 */
+			void update(const double *inputs, double *outputs, Workspace &workspace, Params p) const;
+
+#ifdef ETUNN_INSTRUMENTATION
+			/**
+			 * @fn	const InferenceStats& NeuralNet::getInferenceStats() const;
+			 *
+			 * @brief	Gets the call count, latency histogram and per-layer time of update().
+			 * 			Only available when the library is built with ETUNN_INSTRUMENTATION.
+			 *
+			 * @return	The statistics.
+			 */
+			const InferenceStats& getInferenceStats() const;
+
+			/**
+			 * @fn	void NeuralNet::resetInferenceStats();
+			 *
+			 * @brief	Discards the recorded statistics of update().
+			 */
+			void resetInferenceStats();
+#endif
 
 			/**
 			 * @fn	inline double NeuralNet::sigmoid(double activation, double response);
@@ -109,15 +202,53 @@ namespace etunn
 			 *
 			 * @return	A double.
 			 */
-			inline double sigmoid(double activation, double response);
+			inline double sigmoid(double activation, double response)
+			{
+				return activate<Activation::Sigmoid>(activation, response);
+			}
 
 		private:
-			int numInputs, numOutputs, numHiddenLayers, neuronsPerHiddenLyr;
+			int numInputs, numOutputs, numHiddenLayers;
+			std::vector<int> hiddenLayerSizes;
+			std::vector<Activation> layerActivations;
+			MathAccuracy accuracy;
 			std::string name;
 
 			//Storage for each layer of neurons including the output layer
 			std::vector<NeuronLayer> layers;
+
+#ifdef ETUNN_INSTRUMENTATION
+			//Recorded by update()
+			mutable InferenceStats inferenceStats;
+#endif
 		};
+
+		//Defined here so that the forward pass inlines into the caller
+		inline void NeuralNet::update(const double *inputs, double *finalOutputs, Workspace &workspace, Params p) const
+		{
+			ETUNN_TIME_UPDATE(inferenceStats);
+
+			//Layers
+			for (int i = 0; i < numHiddenLayers + 1; ++i)
+			{
+				//Stores the resultant outputs of the layer, the last layer writes straight to the caller
+				double *outputs = finalOutputs;
+
+				if (i < numHiddenLayers)
+				{
+					std::vector<double> &buffer = i % 2 ? workspace.layerB : workspace.layerA;
+					buffer.resize(layers[i].numNeurons);
+					outputs = buffer.data();
+				}
+
+				kernels::forwardLayer(layers[i], inputs, outputs, p.bias, p.activationResponse);
+
+				ETUNN_TIME_LAYER(i);
+
+				//The outputs are the inputs of the next layer
+				inputs = outputs;
+			}
+		}
 	}
 }
 
@@ -0,0 +1,162 @@
+/**
+ * @file	evolutionary\PopulationEvaluator.hpp.
+ *
+ * @brief	Declares the population evaluator class.
+ */
+#ifndef POPULATIONEVALUATOR_H
+#define POPULATIONEVALUATOR_H
+
+#include <vector>
+
+#include "../Params.hpp"
+#include "../Topology.hpp"
+#include "Genome.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @class	PopulationEvaluator
+		 *
+		 * @brief	Runs many genomes on a fixed set of inputs without creating a NeuralNet for each:
+		 * 			the forward pass works directly on the flat weights (in the order of getWeights())
+		 * 			using only the topology. The inputs are kept transposed in blocks of a few samples;
+		 * 			every genome is run on one block before moving on to the next, so the block stays
+		 * 			in cache while the weights stream through, and every weight is applied to all
+		 * 			samples of the block at once. Results match update() up to floating point rounding.
+		 *
+		 * 			For small nets the population can instead be interleaved, storing the same weight
+		 * 			of several genomes next to each other, so every vector instruction advances one
+		 * 			network per lane (see interleave() and evaluateInterleaved()).
+		 */
+		class PopulationEvaluator
+		{
+		public:
+			/**
+			 * @fn	PopulationEvaluator::PopulationEvaluator(const Topology &topology, const std::vector<std::vector<double> > &inputs, Params p);
+			 *
+			 * @brief	Constructor. Inputs of the wrong size are replaced by zeros.
+			 *
+			 * @param	topology	The topology of the networks (NeuralNet::getTopology()).
+			 * @param	inputs  	The inputs the networks are evaluated on.
+			 * @param	p			Variable arguments providing additional information.
+			 */
+			PopulationEvaluator(const Topology &topology, const std::vector<std::vector<double> > &inputs, Params p);
+
+			/**
+			 * @fn	void PopulationEvaluator::evaluate(const double *weights, int numGenomes, int stride, double *outputs);
+			 *
+			 * @brief	Evaluates a block of genomes stored one after another.
+			 *
+			 * @param 		  	weights   	The weights of the first genome.
+			 * @param 		  	numGenomes	Number of genomes.
+			 * @param 		  	stride	  	Distance between the weights of two genomes (at least the number of weights).
+			 * @param [in,out]	outputs   	Receives the outputs, genome after genome, each holding the
+			 * 								outputs of every sample one after another.
+			 */
+			void evaluate(const double *weights, int numGenomes, int stride, double *outputs);
+
+			/**
+			 * @fn	void PopulationEvaluator::evaluate(const std::vector<Genome> &population, std::vector<double> &outputs);
+			 *
+			 * @brief	Evaluates a population. Genomes of the wrong size get zero outputs.
+			 *
+			 * @param 		  	population	The population.
+			 * @param [in,out]	outputs   	Set to the outputs, laid out like in evaluate() above.
+			 */
+			void evaluate(const std::vector<Genome> &population, std::vector<double> &outputs);
+
+			/**
+			 * @fn	void PopulationEvaluator::interleave(const std::vector<Genome> &population, std::vector<double> &block) const;
+			 *
+			 * @brief	Interleaves a population for evaluateInterleaved(). The genomes are stored in groups
+			 * 			of getGroupSize(); within a group, weight w of genome g is at w * getGroupSize() + g.
+			 * 			Missing genomes of the last group and genomes of the wrong size are zeros.
+			 *
+			 * @param 		  	population	The population.
+			 * @param [in,out]	block	  	Set to the interleaved weights.
+			 */
+			void interleave(const std::vector<Genome> &population, std::vector<double> &block) const;
+
+			/**
+			 * @fn	void PopulationEvaluator::evaluateInterleaved(const double *block, int numGenomes, double *outputs);
+			 *
+			 * @brief	Evaluates an interleaved population, one vector lane per genome.
+			 *
+			 * @param 		  	block	  	The weights, interleaved like by interleave().
+			 * @param 		  	numGenomes	Number of genomes.
+			 * @param [in,out]	outputs   	Receives the outputs, laid out like in evaluate().
+			 */
+			void evaluateInterleaved(const double *block, int numGenomes, double *outputs);
+
+			/**
+			 * @fn	void PopulationEvaluator::evaluateInterleaved(const std::vector<Genome> &population, std::vector<double> &outputs);
+			 *
+			 * @brief	Interleaves and evaluates a population. Genomes of the wrong size get zero outputs.
+			 *
+			 * @param 		  	population	The population.
+			 * @param [in,out]	outputs   	Set to the outputs, laid out like in evaluate().
+			 */
+			void evaluateInterleaved(const std::vector<Genome> &population, std::vector<double> &outputs);
+
+			/**
+			 * @fn	static int PopulationEvaluator::getGroupSize();
+			 *
+			 * @brief	Gets the number of genomes interleaved together, a multiple of the vector width the
+			 * 			library was built for.
+			 *
+			 * @return	The group size.
+			 */
+			static int getGroupSize();
+
+			/**
+			 * @fn	int PopulationEvaluator::getNumberOfSamples() const;
+			 *
+			 * @brief	Gets the number of input samples.
+			 *
+			 * @return	The number of samples.
+			 */
+			int getNumberOfSamples() const;
+
+			/**
+			 * @fn	int PopulationEvaluator::getNumberOfOutputs() const;
+			 *
+			 * @brief	Gets the number of outputs per sample.
+			 *
+			 * @return	The number of outputs.
+			 */
+			int getNumberOfOutputs() const;
+
+		private:
+			Topology topology;
+			double bias, response;
+			int numSamples, numBlocks, numOutputs, numWeights;
+
+			/** @brief	The inputs, block after block, each stored input by input with the samples of the block. */
+			std::vector<double> inputBlocks;
+
+			/** @brief	Outputs of the even and odd layers for one block, stored like the inputs. */
+			std::vector<double> layerA, layerB;
+
+			/** @brief	The population interleaved by evaluateInterleaved(). */
+			std::vector<double> interleaved;
+
+			/**
+			 * @fn	void PopulationEvaluator::forwardBlock(const double *weights, int block, double *outputs);
+			 *
+			 * @brief	Runs one genome on one block of samples.
+			 */
+			void forwardBlock(const double *weights, int block, double *outputs);
+
+			/**
+			 * @fn	void PopulationEvaluator::forwardGroup(const double *weights, int sample, int count, double *outputs);
+			 *
+			 * @brief	Runs one group of interleaved genomes on one sample.
+			 */
+			void forwardGroup(const double *weights, int sample, int count, double *outputs);
+		};
+	}
+}
+
+#endif
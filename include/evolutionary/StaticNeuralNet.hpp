@@ -0,0 +1,181 @@
+/**
+ * @file	evolutionary\StaticNeuralNet.hpp.
+ *
+ * @brief	Declares the fixed-topology neural net template.
+ */
+#ifndef EVOL_STATICNEURALNET_H
+#define EVOL_STATICNEURALNET_H
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "../Params.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		namespace detail
+		{
+			/**
+			 * @struct	StaticLayers
+			 *
+			 * @brief	Compile-time description of the layers between the given sizes.
+			 */
+			template<int... Sizes>
+			struct StaticLayers;
+
+			template<int Inputs, int Outputs>
+			struct StaticLayers<Inputs, Outputs>
+			{
+				/** @brief	Number of weights (including biases). */
+				static const int numWeights = Outputs * (Inputs + 1);
+
+				/** @brief	Number of outputs of the last layer. */
+				static const int numOutputs = Outputs;
+
+				/**
+				 * @fn	static void forward(const double *weights, const double *inputs, double *outputs, double bias, double response, MathAccuracy accuracy)
+				 *
+				 * @brief	Runs a single layer. All loop bounds are constants, so the compiler can unroll them.
+				 */
+				static void forward(const double *weights, const double *inputs, double *outputs, double bias, double response, MathAccuracy accuracy)
+				{
+					for (int j = 0; j < Outputs; ++j)
+					{
+						const double *w = weights + j * (Inputs + 1);
+						double netinput = 0;
+
+						for (int k = 0; k < Inputs; ++k)
+						{
+							netinput += w[k] * inputs[k];
+						}
+
+						//Add in the bias
+						netinput += w[Inputs] * bias;
+
+						outputs[j] = activate(Activation::Sigmoid, netinput, response, accuracy);
+					}
+				}
+			};
+
+			template<int Inputs, int Outputs, int... Rest>
+			struct StaticLayers<Inputs, Outputs, Rest...>
+			{
+				typedef StaticLayers<Inputs, Outputs> First;
+				typedef StaticLayers<Outputs, Rest...> Next;
+
+				static const int numWeights = First::numWeights + Next::numWeights;
+				static const int numOutputs = Next::numOutputs;
+
+				static void forward(const double *weights, const double *inputs, double *outputs, double bias, double response, MathAccuracy accuracy)
+				{
+					//The intermediate outputs live on the stack
+					double hidden[Outputs];
+
+					First::forward(weights, inputs, hidden, bias, response, accuracy);
+					Next::forward(weights + First::numWeights, hidden, outputs, bias, response, accuracy);
+				}
+			};
+		}
+
+		/**
+		 * @class	StaticNeuralNet
+		 *
+		 * @brief	A neural net whose topology is fixed at compile time, e.g. StaticNeuralNet<8, 16, 4>.
+		 * 			The first size is the number of inputs, the last one the number of outputs.
+		 * 			Weights use the same layout as NeuralNet::getWeights(), so a Genome of a
+		 * 			NeuralNet with the same (sigmoid) topology can be loaded with putWeights(genome.weights).
+		 */
+		template<int Inputs, int... Sizes>
+		class StaticNeuralNet
+		{
+			typedef detail::StaticLayers<Inputs, Sizes...> Layers;
+
+		public:
+
+			/** @brief	Number of inputs. */
+			static const int numInputs = Inputs;
+
+			/** @brief	Number of outputs. */
+			static const int numOutputs = Layers::numOutputs;
+
+			/** @brief	Total number of weights (including biases). */
+			static const int numWeights = Layers::numWeights;
+
+			/**
+			 * @fn	StaticNeuralNet::StaticNeuralNet(Params p)
+			 *
+			 * @brief	Constructor. All weights are zero.
+			 *
+			 * @param	p	Variable arguments providing additional information.
+			 */
+			StaticNeuralNet(Params p) : bias(p.bias), response(p.activationResponse), accuracy(p.mathAccuracy)
+			{
+				weights.fill(0);
+			}
+
+			/**
+			 * @fn	bool StaticNeuralNet::putWeights(const std::vector<double> &newWeights)
+			 *
+			 * @brief	Replaces the weights with new ones.
+			 *
+			 * @param	newWeights	The weights.
+			 *
+			 * @return	False (leaving the weights untouched) if the amount of weights does not match.
+			 */
+			bool putWeights(const std::vector<double> &newWeights)
+			{
+				if ((int)newWeights.size() != numWeights)
+				{
+					return false;
+				}
+
+				for (int i = 0; i < numWeights; ++i)
+				{
+					weights[i] = newWeights[i];
+				}
+
+				return true;
+			}
+
+			/**
+			 * @fn	std::vector<double> StaticNeuralNet::getWeights() const
+			 *
+			 * @brief	Gets the weights from the network.
+			 *
+			 * @return	The weights.
+			 */
+			std::vector<double> getWeights() const
+			{
+				return std::vector<double>(weights.begin(), weights.end());
+			}
+
+			/**
+			 * @fn	std::array<double, numOutputs> StaticNeuralNet::update(const std::array<double, numInputs> &inputs) const
+			 *
+			 * @brief	Calculates the outputs from a set of inputs.
+			 *
+			 * @param	inputs	The inputs.
+			 *
+			 * @return	The output of the network.
+			 */
+			std::array<double, numOutputs> update(const std::array<double, numInputs> &inputs) const
+			{
+				std::array<double, numOutputs> outputs;
+				Layers::forward(weights.data(), inputs.data(), outputs.data(), bias, response, accuracy);
+
+				return outputs;
+			}
+
+		private:
+			std::array<double, numWeights> weights;
+			double bias;
+			double response;
+			MathAccuracy accuracy;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file	evolutionary\StoppingCriteria.hpp.
+ *
+ * @brief	Declares the stopping criteria of GeneticAlgorithm::run().
+ */
+#ifndef STOPPINGCRITERIA_H
+#define STOPPINGCRITERIA_H
+
+#include <limits>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		/**
+		 * @enum	StopReason
+		 *
+		 * @brief	Why GeneticAlgorithm::run() returned.
+		 */
+		enum class StopReason
+		{
+			/** @brief	The best fitness reached the target. */
+			TargetReached,
+
+			/** @brief	The best fitness did not improve for too many generations. */
+			Stagnation,
+
+			/** @brief	The weights of the population became too similar. */
+			DiversityCollapse,
+
+			/** @brief	The wall-clock budget ran out. */
+			TimeBudget,
+
+			/** @brief	The maximum number of generations was run. */
+			MaxGenerations
+		};
+
+		/**
+		 * @struct	StoppingCriteria
+		 *
+		 * @brief	When GeneticAlgorithm::run() stops. A criterion is off while its value is 0 (the
+		 * 			target while it is infinite); run() stops at the first criterion met after a generation.
+		 */
+		struct StoppingCriteria
+		{
+			/** @brief	Stop once the best fitness reaches this value. */
+			double targetFitness;
+
+			/** @brief	Stop after this many generations without an improvement of the best fitness. */
+			int stagnationGenerations;
+
+			/** @brief	Stop once FitnessStats::diversity drops below this value. */
+			double minDiversity;
+
+			/** @brief	Stop once this many seconds have passed since run() was called. */
+			double maxSeconds;
+
+			/** @brief	Stop after this many generations. */
+			int maxGenerations;
+
+			/**
+			 * @fn	StoppingCriteria()
+			 *
+			 * @brief	Default constructor. All criteria are off.
+			 */
+			StoppingCriteria() : targetFitness(std::numeric_limits<double>::infinity()), stagnationGenerations(0),
+				minDiversity(0), maxSeconds(0), maxGenerations(0) {}
+		};
+
+		/**
+		 * @fn	const char* stopReasonName(StopReason reason);
+		 *
+		 * @brief	Gets the name of a stop reason.
+		 *
+		 * @param	reason	The reason.
+		 *
+		 * @return	The name, e.g. "stagnation".
+		 */
+		const char* stopReasonName(StopReason reason);
+	}
+}
+
+#endif
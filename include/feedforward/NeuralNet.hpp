@@ -10,17 +10,16 @@
 #include <string>
 #include <vector>
 
+#include "../Dataset.hpp"
 #include "../NeuralNetConfiguration.hpp"
+#include "../InferenceStats.hpp"
+#include "../Kernels.hpp"
+#include "../Optimizer.hpp"
 #include "../Params.hpp"
 #include "../Neuron.hpp"
 #include "../NeuronLayer.hpp"
-
-/**
- * @def	NUM_E
- *
- * @brief	A macro that defines the number e.
- */
-#define NUM_E 2.71828182846
+#include "../Topology.hpp"
+#include "../Workspace.hpp"
 
 namespace etunn
 {
@@ -76,6 +75,15 @@ namespace etunn
 			 */
 			int getNumberOfWeights() const;
 
+			/**
+			 * @fn	Topology NeuralNet::getTopology() const;
+			 *
+			 * @brief	Gets the size and activation function of every layer.
+			 *
+			 * @return	The topology.
+			 */
+			Topology getTopology() const;
+
 			/**
 			 * @fn	void NeuralNet::putWeights(std::vector<double> &weights);
 			 *
@@ -86,27 +94,122 @@ namespace etunn
 			void putWeights(std::vector<double> &weights);
 
 			/**
-			 * @fn	std::vector<double> NeuralNet::update(std::vector<double> &inputs, Params p);
+			 * @fn	std::vector<double> NeuralNet::update(const std::vector<double> &inputs, Params p) const;
 			 *
-			 * @brief	Calculates the outputs from a set of inputs.
+			 * @brief	Calculates the outputs from a set of inputs. Safe to call from several threads at once.
 			 *
-			 * @param [in,out]	inputs	The inputs.
-			 * @param 		  	p	  	Variable arguments providing additional information.
+			 * @param	inputs	The inputs.
+			 * @param	p	  	Variable arguments providing additional information.
 			 *
 			 * @return	The output of the network.
 			 */
-			std::vector<double> update(std::vector<double> &inputs, Params p);
+			std::vector<double> update(const std::vector<double> &inputs, Params p) const;
+
+			/**
+			 * @fn	std::vector<double> NeuralNet::update(const double *inputs, Params p) const;
+			 *
+			 * @brief	Calculates the outputs from inputs stored elsewhere (e.g. a row of a Batch),
+			 * 			without copying them into a vector. Safe to call from several threads at once.
+			 *
+			 * @param	inputs	The inputs, as many as the network has.
+			 * @param	p	  	Variable arguments providing additional information.
+			 *
+			 * @return	The output of the network.
+			 */
+			std::vector<double> update(const double *inputs, Params p) const;
+
+			/**
+			 * @fn	Workspace NeuralNet::createWorkspace() const;
+			 *
+			 * @brief	Creates scratch space large enough for update() with a workspace.
+			 *
+			 * @return	The workspace.
+			 */
+			Workspace createWorkspace() const;
+
+			/**
+			 * @fn	void NeuralNet::update(const double *inputs, double *outputs, Workspace &workspace, Params p) const;
+			 *
+			 * @brief	Calculates the outputs from a set of inputs without allocating (given a workspace
+			 * 			from createWorkspace()). Safe to call from several threads at once as long as each
+			 * 			uses its own workspace.
+			 *
+			 * @param 		  	inputs   	The inputs, as many as the network has.
+			 * @param [in,out]	outputs  	Receives the outputs, as many as the network has.
+			 * @param [in,out]	workspace	The scratch space.
+			 * @param 		  	p		 	Variable arguments providing additional information.
+			 */
+			void update(const double *inputs, double *outputs, Workspace &workspace, Params p) const;
+
+#ifdef ETUNN_INSTRUMENTATION
+			/**
+			 * @fn	const InferenceStats& NeuralNet::getInferenceStats() const;
+			 *
+			 * @brief	Gets the call count, latency histogram and per-layer time of update().
+			 * 			Only available when the library is built with ETUNN_INSTRUMENTATION.
+			 *
+			 * @return	The statistics.
+			 */
+			const InferenceStats& getInferenceStats() const;
+
+			/**
+			 * @fn	void NeuralNet::resetInferenceStats();
+			 *
+			 * @brief	Discards the recorded statistics of update().
+			 */
+			void resetInferenceStats();
+#endif
+
+			/*Training: forward() keeps the outputs of every layer, backprop() turns them into gradients
+			and applyGradients() hands the averaged gradients to an optimizer*/
+
+			/**
+			 * @fn	std::vector<double> NeuralNet::forward(const std::vector<double> &inputs, Params p);
+			 *
+			 * @brief	Calculates the outputs like update(), keeping the outputs of every layer for backprop().
+			 *
+			 * @param	inputs	The inputs.
+			 * @param	p	  	Variable arguments providing additional information.
+			 *
+			 * @return	The output of the network, or an empty vector if the amount of inputs is wrong.
+			 */
+			std::vector<double> forward(const std::vector<double> &inputs, Params p);
 
 			/**
 			 * @fn	void NeuralNet::backprop(std::vector<double> outputs, std::vector<double> desiredOutputs);
 			 *
-			 * @brief	Trains the network.
+			 * @brief	Adds the gradients of the squared error (half the sum of (output - desired)^2) of the
+			 * 			last forward() pass to the accumulated gradients. The weights only change in
+			 * 			applyGradients(), so calling this once per sample trains on mini-batches.
 			 *
-			 * @param	outputs		  	The outputs.
+			 * @param	outputs		  	The outputs returned by forward().
 			 * @param	desiredOutputs	The desired outputs.
 			 */
 			void backprop(std::vector<double> outputs, std::vector<double> desiredOutputs);
 
+			/**
+			 * @fn	void NeuralNet::applyGradients(Optimizer &optimizer);
+			 *
+			 * @brief	Updates the weights with the gradients accumulated since the last call, averaged over
+			 * 			the number of backprop() calls, and clears them.
+			 *
+			 * @param [in,out]	optimizer	The optimizer (use the same one for the whole training).
+			 */
+			void applyGradients(Optimizer &optimizer);
+
+			/**
+			 * @fn	double NeuralNet::train(const Batch &batch, Optimizer &optimizer, Params p);
+			 *
+			 * @brief	Runs forward() and backprop() on every row of a batch, then applyGradients().
+			 *
+			 * @param 		  	batch	 	The batch, with as many inputs and targets as the network has inputs and outputs.
+			 * @param [in,out]	optimizer	The optimizer.
+			 * @param 		  	p		 	Variable arguments providing additional information.
+			 *
+			 * @return	The mean squared error of the rows before the update, or -1 if the batch does not fit the network.
+			 */
+			double train(const Batch &batch, Optimizer &optimizer, Params p);
+
 			/**
 			 * @fn	inline double NeuralNet::sigmoid(double activation, double response);
 			 *
@@ -117,12 +220,77 @@ namespace etunn
 			 *
 			 * @return	A double.
 			 */
-			inline double sigmoid(double activation, double response);
+			inline double sigmoid(double activation, double response)
+			{
+				return activate<Activation::Sigmoid>(activation, response);
+			}
 
 		private:
-			int numInputs, numOutputs, numHiddenLayers, neuronsPerHiddenLyr;
+			int numInputs, numOutputs, numHiddenLayers;
+			std::vector<int> hiddenLayerSizes;
+			std::vector<Activation> layerActivations;
+			MathAccuracy accuracy;
 			std::vector<NeuronLayer> layers;
+
+			/** @brief	Outputs of every layer of the last forward() pass, starting with the inputs. */
+			std::vector<std::vector<double> > activations;
+
+			/** @brief	Accumulated gradients, in the order of getWeights(), and the number of backprop() calls. */
+			std::vector<double> gradients;
+			int numAccumulated;
+
+			/** @brief	Index of the first weight of each layer. */
+			std::vector<int> layerOffsets;
+
+			/** @brief	Scratch space of backprop(): the error terms of the current and previous layer. */
+			std::vector<double> deltas, previousDeltas;
+
+			/**
+			 * @fn	void NeuralNet::forwardPass(const double *inputs, Params p);
+			 *
+			 * @brief	Fills activations with the outputs of every layer.
+			 */
+			void forwardPass(const double *inputs, Params p);
+
+			/**
+			 * @fn	void NeuralNet::backpropagate(const double *outputs, const double *desiredOutputs);
+			 *
+			 * @brief	Adds the gradients of the last forward pass to the accumulated gradients.
+			 */
+			void backpropagate(const double *outputs, const double *desiredOutputs);
+
+#ifdef ETUNN_INSTRUMENTATION
+			//Recorded by update()
+			mutable InferenceStats inferenceStats;
+#endif
 		};
+
+		//Defined here so that the forward pass inlines into the caller
+		inline void NeuralNet::update(const double *inputs, double *finalOutputs, Workspace &workspace, Params p) const
+		{
+			ETUNN_TIME_UPDATE(inferenceStats);
+
+			//Layers
+			for (int i = 0; i < numHiddenLayers + 1; ++i)
+			{
+				//Stores the resultant outputs of the layer, the last layer writes straight to the caller
+				double *outputs = finalOutputs;
+
+				if (i < numHiddenLayers)
+				{
+					std::vector<double> &buffer = i % 2 ? workspace.layerB : workspace.layerA;
+					buffer.resize(layers[i].numNeurons);
+					outputs = buffer.data();
+				}
+
+				kernels::forwardLayer(layers[i], inputs, outputs, p.bias, p.activationResponse);
+
+				ETUNN_TIME_LAYER(i);
+
+				//The outputs are the inputs of the next layer
+				inputs = outputs;
+			}
+		}
 	}
 }
 
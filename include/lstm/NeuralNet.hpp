@@ -0,0 +1,191 @@
+/**
+ * @file	lstm\NeuralNet.hpp.
+ *
+ * @brief	Declares the LSTM neural net class.
+ */
+#ifndef LSTM_NEURALNET_H
+#define LSTM_NEURALNET_H
+
+#include <vector>
+
+#include "../Activation.hpp"
+#include "../NeuralNetConfiguration.hpp"
+#include "../Params.hpp"
+#include "State.hpp"
+
+namespace etunn
+{
+	namespace lstm
+	{
+		/**
+		 * @class	NeuralNet
+		 *
+		 * @brief	A recurrent neural net made of LSTM layers (one per hidden layer) followed by a dense
+		 * 			output layer. All weights live in one flat vector, so the net can be evolved with
+		 * 			evolutionary::GeneticAlgorithm like the other nets. Each LSTM layer stores its four
+		 * 			gates (input, forget, cell, output) fused into one matrix with a row per gate and
+		 * 			neuron, holding the input weights, the recurrent weights and the bias weight.
+		 * 			The output layer stores one row per neuron with its input weights and bias weight.
+		 */
+		class NeuralNet
+		{
+		public:
+
+			/**
+			 * @fn	NeuralNet::NeuralNet();
+			 *
+			 * @brief	Default constructor.
+			 */
+			NeuralNet();
+
+			/**
+			 * @fn	NeuralNet::NeuralNet(Params p);
+			 *
+			 * @brief	Constructor. The hidden layer sizes are the sizes of the LSTM layers and
+			 * 			the activation of the last layer is used by the output layer.
+			 *
+			 * @param	p	Variable arguments providing additional information.
+			 */
+			NeuralNet(Params p);
+
+			/**
+			 * @fn	void NeuralNet::createNet();
+			 *
+			 * @brief	Creates the network with random weights and an empty state.
+			 */
+			void createNet();
+
+			/**
+			 * @fn	std::vector<double> NeuralNet::getWeights() const;
+			 *
+			 * @brief	Gets the weights from the network.
+			 *
+			 * @return	The weights.
+			 */
+			std::vector<double> getWeights() const;
+
+			/**
+			 * @fn	int NeuralNet::getNumberOfWeights() const;
+			 *
+			 * @brief	Returns the total number of weights in the net.
+			 *
+			 * @return	The number of weights.
+			 */
+			int getNumberOfWeights() const;
+
+			/**
+			 * @fn	void NeuralNet::putWeights(std::vector<double> &weights);
+			 *
+			 * @brief	Replaces the weights with new ones. Ignored if the amount is wrong.
+			 *
+			 * @param [in,out]	weights	The weights.
+			 */
+			void putWeights(std::vector<double> &weights);
+
+			/**
+			 * @fn	void NeuralNet::reset();
+			 *
+			 * @brief	Clears the hidden and cell state (e.g. before a new sequence).
+			 */
+			void reset();
+
+			/**
+			 * @fn	std::vector<double> NeuralNet::update(std::vector<double> &inputs, Params p);
+			 *
+			 * @brief	Feeds one time step and advances the state.
+			 *
+			 * @param [in,out]	inputs	The inputs.
+			 * @param 		  	p	  	Variable arguments providing additional information.
+			 *
+			 * @return	The output of the network, or an empty vector if the amount of inputs is wrong.
+			 */
+			std::vector<double> update(std::vector<double> &inputs, Params p);
+
+			/**
+			 * @fn	std::vector<std::vector<double> > NeuralNet::processSequence(const std::vector<std::vector<double> > &sequence, Params p);
+			 *
+			 * @brief	Feeds a whole sequence, continuing from the current state and leaving the state
+			 * 			after the last step. Runs layer by layer over all time steps, so the input part of
+			 * 			the gates is computed for the whole sequence at once while the weights are in cache
+			 * 			and only the recurrent part has to be computed step by step.
+			 *
+			 * @param	sequence	The inputs of each time step.
+			 * @param	p			Variable arguments providing additional information.
+			 *
+			 * @return	The output of each time step, or an empty vector if the amount of inputs is wrong.
+			 */
+			std::vector<std::vector<double> > processSequence(const std::vector<std::vector<double> > &sequence, Params p);
+
+			/*Shared inference: the net stays unchanged and every caller steps its own state*/
+
+			/**
+			 * @fn	State NeuralNet::createState() const;
+			 *
+			 * @brief	Creates a cleared state with buffers preallocated for step().
+			 *
+			 * @return	The state.
+			 */
+			State createState() const;
+
+			/**
+			 * @fn	void NeuralNet::step(const double *inputs, State &state, double *outputs, Params p) const;
+			 *
+			 * @brief	Feeds one time step, advancing the given state instead of the net's own.
+			 * 			Does not allocate for a state from createState().
+			 *
+			 * @param 		  	inputs 	The inputs, as many as the network has.
+			 * @param [in,out]	state  	The state (sized on first use if it does not fit the net).
+			 * @param [in,out]	outputs	Receives the outputs, as many as the network has.
+			 * @param 		  	p	   	Variable arguments providing additional information.
+			 */
+			void step(const double *inputs, State &state, double *outputs, Params p) const;
+
+			/**
+			 * @fn	void NeuralNet::processSequence(const double *inputs, int length, State &state, double *outputs, Params p) const;
+			 *
+			 * @brief	Feeds a sequence, advancing the given state instead of the net's own.
+			 *
+			 * @param 		  	inputs 	The inputs of each time step, one after another.
+			 * @param 		  	length 	Number of time steps.
+			 * @param [in,out]	state  	The state (sized on first use if it does not fit the net).
+			 * @param [in,out]	outputs	Receives the outputs of each time step, one after another.
+			 * @param 		  	p	   	Variable arguments providing additional information.
+			 */
+			void processSequence(const double *inputs, int length, State &state, double *outputs, Params p) const;
+
+		private:
+			int numInputs, numOutputs, numHiddenLayers;
+			std::vector<int> hiddenLayerSizes;
+			Activation outputActivation;
+
+			/** @brief	All weights, layer after layer. */
+			std::vector<double> weights;
+
+			/** @brief	Index of the first weight of each layer, including the output layer. */
+			std::vector<int> layerOffsets;
+
+			/** @brief	Index of the state of each LSTM layer and the size of the state. */
+			std::vector<int> stateOffsets;
+			int stateSize;
+
+			/** @brief	The state used by update() and processSequence(). */
+			State state;
+
+			/**
+			 * @fn	void NeuralNet::forward(const double *inputs, int length, State &state, double *outputs, Params p) const;
+			 *
+			 * @brief	Runs a sequence of the given length (stored row after row) through all layers.
+			 */
+			void forward(const double *inputs, int length, State &state, double *outputs, Params p) const;
+
+			/**
+			 * @fn	void NeuralNet::forwardLayer(int layer, const double *inputs, int length, State &state, double *outputs, Params p) const;
+			 *
+			 * @brief	Runs a sequence through one LSTM layer, advancing its state.
+			 */
+			void forwardLayer(int layer, const double *inputs, int length, State &state, double *outputs, Params p) const;
+		};
+	}
+}
+
+#endif
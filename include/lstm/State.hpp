@@ -0,0 +1,72 @@
+/**
+ * @file	lstm\State.hpp.
+ *
+ * @brief	Declares the state of an LSTM net.
+ */
+#ifndef LSTM_STATE_H
+#define LSTM_STATE_H
+
+#include <algorithm>
+#include <vector>
+
+namespace etunn
+{
+	namespace lstm
+	{
+		class NeuralNet;
+
+		/**
+		 * @class	State
+		 *
+		 * @brief	The hidden and cell state of all layers of an LSTM net, plus the scratch space
+		 * 			a step needs. Keeping it apart from the net lets any number of agents (or threads)
+		 * 			share one net, each stepping their own state. Create it with NeuralNet::createState();
+		 * 			stepping a state never allocates once its buffers are large enough.
+		 */
+		class State
+		{
+		public:
+
+			/**
+			 * @fn	State()
+			 *
+			 * @brief	Default constructor. The state gets its size on first use.
+			 */
+			State() {}
+
+			/**
+			 * @fn	void reset()
+			 *
+			 * @brief	Clears the hidden and cell state (e.g. before a new sequence).
+			 */
+			void reset()
+			{
+				std::fill(hidden.begin(), hidden.end(), 0.0);
+				std::fill(cell.begin(), cell.end(), 0.0);
+			}
+
+			/**
+			 * @fn	const std::vector<double>& getHidden() const
+			 *
+			 * @brief	Gets the hidden state of all layers, layer after layer.
+			 *
+			 * @return	The hidden state.
+			 */
+			const std::vector<double>& getHidden() const
+			{
+				return hidden;
+			}
+
+		private:
+			friend class NeuralNet;
+
+			/** @brief	Hidden and cell state of all layers, layer after layer. */
+			std::vector<double> hidden, cell;
+
+			/** @brief	Scratch space: layer inputs and outputs of a sequence and the gate activations. */
+			std::vector<double> sequenceA, sequenceB, gates;
+		};
+	}
+}
+
+#endif
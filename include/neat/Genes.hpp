@@ -0,0 +1,89 @@
+/**
+ * @file	neat\Genes.hpp.
+ *
+ * @brief	Declares the node and connection genes.
+ */
+#ifndef NEAT_GENES_H
+#define NEAT_GENES_H
+
+namespace etunn
+{
+	namespace neat
+	{
+		/**
+		 * @enum	NodeType
+		 *
+		 * @brief	The role of a node in the network.
+		 */
+		enum class NodeType
+		{
+			Input,
+			Bias,
+			Hidden,
+			Output
+		};
+
+		/**
+		 * @struct	NodeGene
+		 *
+		 * @brief	A node gene.
+		 */
+		struct NodeGene
+		{
+			/** @brief	The node id (shared by all genomes via the InnovationTracker). */
+			int id;
+
+			/** @brief	The node type. */
+			NodeType type;
+
+			/**
+			 * @fn	NodeGene(int id, NodeType type)
+			 *
+			 * @brief	Constructor.
+			 *
+			 * @param	id  	The node id.
+			 * @param	type	The node type.
+			 */
+			NodeGene(int id, NodeType type) : id(id), type(type) {}
+		};
+
+		/**
+		 * @struct	ConnectionGene
+		 *
+		 * @brief	A connection gene.
+		 */
+		struct ConnectionGene
+		{
+			/** @brief	The id of the source node. */
+			int from;
+
+			/** @brief	The id of the target node. */
+			int to;
+
+			/** @brief	The weight. */
+			double weight;
+
+			/** @brief	Whether the connection is expressed in the network. */
+			bool enabled;
+
+			/** @brief	The historical marking used to line up genes during crossover. */
+			int innovation;
+
+			/**
+			 * @fn	ConnectionGene(int from, int to, double weight, bool enabled, int innovation)
+			 *
+			 * @brief	Constructor.
+			 *
+			 * @param	from	  	The id of the source node.
+			 * @param	to		  	The id of the target node.
+			 * @param	weight	  	The weight.
+			 * @param	enabled   	Whether the connection is enabled.
+			 * @param	innovation	The innovation number.
+			 */
+			ConnectionGene(int from, int to, double weight, bool enabled, int innovation)
+				: from(from), to(to), weight(weight), enabled(enabled), innovation(innovation) {}
+		};
+	}
+}
+
+#endif
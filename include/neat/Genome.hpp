@@ -0,0 +1,180 @@
+/**
+ * @file	neat\Genome.hpp.
+ *
+ * @brief	Declares the topology-evolving genome class.
+ */
+#ifndef NEAT_GENOME_H
+#define NEAT_GENOME_H
+
+#include <vector>
+#include "Genes.hpp"
+#include "InnovationTracker.hpp"
+
+namespace etunn
+{
+	namespace neat
+	{
+		/**
+		 * @class	Genome
+		 *
+		 * @brief	A genome describing both the structure and the weights of a network.
+		 * 			Nodes are kept sorted by id and connections by innovation number.
+		 * 			Only feedforward structures are generated, so the network never contains cycles.
+		 */
+		class Genome
+		{
+		public:
+
+			/** @brief	The node genes. */
+			std::vector<NodeGene> nodes;
+
+			/** @brief	The connection genes. */
+			std::vector<ConnectionGene> connections;
+
+			/** @brief	The fitness */
+			double fitness;
+
+			/**
+			 * @fn	Genome::Genome();
+			 *
+			 * @brief	Default constructor.
+			 */
+			Genome();
+
+			/**
+			 * @fn	Genome::Genome(int numInputs, int numOutputs, InnovationTracker &tracker);
+			 *
+			 * @brief	Creates a minimal genome with every input and the bias connected to every output.
+			 *
+			 * @param 		  	numInputs 	Number of inputs.
+			 * @param 		  	numOutputs	Number of outputs.
+			 * @param [in,out]	tracker   	The innovation tracker.
+			 */
+			Genome(int numInputs, int numOutputs, InnovationTracker &tracker);
+
+			/**
+			 * @fn	void Genome::mutateWeights(double mutationRate, double maxPerturbation);
+			 *
+			 * @brief	Perturbs each weight depending on the mutation rate.
+			 *
+			 * @param	mutationRate   	The mutation rate.
+			 * @param	maxPerturbation	The maximum amount a weight can be tweaked.
+			 */
+			void mutateWeights(double mutationRate, double maxPerturbation);
+
+			/**
+			 * @fn	bool Genome::addConnection(InnovationTracker &tracker);
+			 *
+			 * @brief	Connects two previously unconnected nodes without creating a cycle.
+			 *
+			 * @param [in,out]	tracker	The innovation tracker.
+			 *
+			 * @return	True if a connection was added.
+			 */
+			bool addConnection(InnovationTracker &tracker);
+
+			/**
+			 * @fn	bool Genome::addNode(InnovationTracker &tracker);
+			 *
+			 * @brief	Splits an enabled connection with a new hidden node.
+			 *
+			 * @param [in,out]	tracker	The innovation tracker.
+			 *
+			 * @return	True if a node was added.
+			 */
+			bool addNode(InnovationTracker &tracker);
+
+			/**
+			 * @fn	double Genome::compatibility(const Genome &other) const;
+			 *
+			 * @brief	Calculates the compatibility distance used for speciation
+			 * 			(excess and disjoint genes plus the average weight difference of matching genes).
+			 *
+			 * @param	other	The other genome.
+			 *
+			 * @return	The distance.
+			 */
+			double compatibility(const Genome &other) const;
+
+			/**
+			 * @fn	static Genome Genome::crossover(const Genome &fitter, const Genome &other);
+			 *
+			 * @brief	Crossovers two genomes. The structure is inherited from the fitter parent,
+			 * 			the weights of matching genes from either parent.
+			 *
+			 * @param	fitter	The fitter parent.
+			 * @param	other 	The other parent.
+			 *
+			 * @return	The offspring.
+			 */
+			static Genome crossover(const Genome &fitter, const Genome &other);
+
+			/**
+			 * @fn	int Genome::getNumInputs() const;
+			 *
+			 * @brief	Gets the number of inputs.
+			 *
+			 * @return	The number of inputs.
+			 */
+			int getNumInputs() const;
+
+			/**
+			 * @fn	int Genome::getNumOutputs() const;
+			 *
+			 * @brief	Gets the number of outputs.
+			 *
+			 * @return	The number of outputs.
+			 */
+			int getNumOutputs() const;
+
+			/**
+			 * @fn	friend bool operator< (const Genome& lhs, const Genome& rhs)
+			 *
+			 * @brief	Overload '<' used for sorting.
+			 *
+			 * @param	lhs	The first instance to compare.
+			 * @param	rhs	The second instance to compare.
+			 *
+			 * @return	True if the first parameter is less than the second.
+			 */
+			friend bool operator < (const Genome& lhs, const Genome& rhs)
+			{
+				return (lhs.fitness < rhs.fitness);
+			}
+
+		private:
+
+			/**
+			 * @fn	bool Genome::hasPath(int from, int to) const;
+			 *
+			 * @brief	Checks whether a node can be reached from another node.
+			 *
+			 * @param	from	The start node.
+			 * @param	to  	The node to look for.
+			 *
+			 * @return	True if there is a path.
+			 */
+			bool hasPath(int from, int to) const;
+
+			/**
+			 * @fn	void Genome::insertNode(const NodeGene &node);
+			 *
+			 * @brief	Inserts a node keeping the nodes sorted by id.
+			 *
+			 * @param	node	The node.
+			 */
+			void insertNode(const NodeGene &node);
+
+			/**
+			 * @fn	void Genome::insertConnection(const ConnectionGene &connection);
+			 *
+			 * @brief	Inserts a connection keeping the connections sorted by innovation number.
+			 *
+			 * @param	connection	The connection.
+			 */
+			void insertConnection(const ConnectionGene &connection);
+		};
+	}
+}
+
+#endif
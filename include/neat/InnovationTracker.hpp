@@ -0,0 +1,76 @@
+/**
+ * @file	neat\InnovationTracker.hpp.
+ *
+ * @brief	Declares the innovation tracker class.
+ */
+#ifndef NEAT_INNOVATIONTRACKER_H
+#define NEAT_INNOVATIONTRACKER_H
+
+#include <map>
+#include <utility>
+
+namespace etunn
+{
+	namespace neat
+	{
+		/**
+		 * @class	InnovationTracker
+		 *
+		 * @brief	Hands out innovation numbers and node ids, so that the same structural
+		 * 			mutation gets the same numbers in every genome of a run.
+		 */
+		class InnovationTracker
+		{
+		public:
+
+			/**
+			 * @fn	InnovationTracker::InnovationTracker(int numNodes);
+			 *
+			 * @brief	Constructor.
+			 *
+			 * @param	numNodes	Number of nodes already in use (inputs, bias and outputs).
+			 */
+			InnovationTracker(int numNodes);
+
+			/**
+			 * @fn	int InnovationTracker::getConnectionInnovation(int from, int to);
+			 *
+			 * @brief	Gets the innovation number of a connection, creating it if necessary.
+			 *
+			 * @param	from	The id of the source node.
+			 * @param	to  	The id of the target node.
+			 *
+			 * @return	The innovation number.
+			 */
+			int getConnectionInnovation(int from, int to);
+
+			/**
+			 * @fn	int InnovationTracker::getSplitNode(int innovation);
+			 *
+			 * @brief	Gets the id of the node that splits the given connection, creating it if necessary.
+			 *
+			 * @param	innovation	The innovation number of the split connection.
+			 *
+			 * @return	The node id.
+			 */
+			int getSplitNode(int innovation);
+
+			/**
+			 * @fn	int InnovationTracker::createNode();
+			 *
+			 * @brief	Creates a node id that has never been used before.
+			 *
+			 * @return	The node id.
+			 */
+			int createNode();
+
+		private:
+			int nextNode;
+			int nextInnovation;
+			std::map<std::pair<int, int>, int> connections;
+			std::map<int, int> splits;
+		};
+	}
+}
+
+#endif
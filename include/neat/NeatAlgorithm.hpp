@@ -0,0 +1,145 @@
+/**
+ * @file	neat\NeatAlgorithm.hpp.
+ *
+ * @brief	Declares the topology-evolving genetic algorithm class.
+ */
+#ifndef NEAT_NEATALGORITHM_H
+#define NEAT_NEATALGORITHM_H
+
+#include <vector>
+
+#include "../Params.hpp"
+#include "Genome.hpp"
+#include "InnovationTracker.hpp"
+#include "Network.hpp"
+#include "Species.hpp"
+
+namespace etunn
+{
+	namespace neat
+	{
+		/**
+		 * @class	NeatAlgorithm
+		 *
+		 * @brief	A genetic algorithm that evolves the structure of the networks along with their weights
+		 * 			(NeuroEvolution of Augmenting Topologies). Starts from minimal networks and protects
+		 * 			new structures by letting genomes only compete within their species.
+		 */
+		class NeatAlgorithm
+		{
+		public:
+
+			/**
+			 * @fn	NeatAlgorithm::NeatAlgorithm(int popSize, double mutRat, double crossRat, int numInputs, int numOutputs);
+			 *
+			 * @brief	Constructor.
+			 *
+			 * @param	popSize   	Size of the population.
+			 * @param	mutRat	  	The mutation rate.
+			 * @param	crossRat  	The crossover rate.
+			 * @param	numInputs 	Number of inputs.
+			 * @param	numOutputs	Number of outputs.
+			 */
+			NeatAlgorithm(int popSize, double mutRat, double crossRat, int numInputs, int numOutputs);
+
+			/**
+			 * @fn	std::vector<Genome> NeatAlgorithm::epoch(std::vector<Genome> &old_pop, Params p);
+			 *
+			 * @brief	Runs the algorithm for one generation.
+			 *
+			 * @param [in,out]	old_pop	The old population (with the fitness of every genome set).
+			 * @param 		  	p	   	Variable arguments providing additional information.
+			 *
+			 * @return	The new population.
+			 */
+			std::vector<Genome> epoch(std::vector<Genome> &old_pop, Params p);
+
+			/*Accessor methods*/
+
+			/**
+			 * @fn	std::vector<Genome> NeatAlgorithm::getChromos() const;
+			 *
+			 * @brief	Gets the chromosomes.
+			 *
+			 * @return	The chromosomes.
+			 */
+			std::vector<Genome> getChromos() const;
+
+			/**
+			 * @fn	double NeatAlgorithm::getAverageFitness() const;
+			 *
+			 * @brief	Gets average fitness.
+			 *
+			 * @return	The average fitness.
+			 */
+			double getAverageFitness() const;
+
+			/**
+			 * @fn	double NeatAlgorithm::getBestFitness() const;
+			 *
+			 * @brief	Gets best fitness.
+			 *
+			 * @return	The best fitness.
+			 */
+			double getBestFitness() const;
+
+			/**
+			 * @fn	int NeatAlgorithm::getNumSpecies() const;
+			 *
+			 * @brief	Gets the number of species.
+			 *
+			 * @return	The number of species.
+			 */
+			int getNumSpecies() const;
+
+		private:
+			/** @brief	Entire population of chromosomes. */
+			std::vector<Genome> population;
+
+			/** @brief	The species of the population. */
+			std::vector<Species> species;
+
+			/** @brief	Innovation numbers shared by the whole run. */
+			InnovationTracker innovations;
+
+			/** @brief	Size of population. */
+			int popSize;
+
+			/** @brief	Probability that a weight gets mutated. */
+			double mutationRate;
+
+			/** @brief	Probability of two parents being crossed over instead of cloned. */
+			double crossoverRate;
+
+			/** @brief	Best fitness this population. */
+			double bestFitness;
+
+			/** @brief	Average fitness this population. */
+			double averageFitness;
+
+			/** @brief	Keeps track of the best genome. */
+			int fittestGenome;
+
+			/** @brief	Generation counter. */
+			int generation;
+
+			/**
+			 * @fn	void NeatAlgorithm::speciate(double threshold);
+			 *
+			 * @brief	Assigns every genome to the first species it is compatible with.
+			 *
+			 * @param	threshold	The compatibility threshold.
+			 */
+			void speciate(double threshold);
+
+			/**
+			 * @fn	void NeatAlgorithm::calculateBestAv();
+			 *
+			 * @brief	Calculates the best and average fitness.
+			 */
+			void calculateBestAv();
+		};
+	}
+}
+
+#endif
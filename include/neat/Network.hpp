@@ -0,0 +1,81 @@
+/**
+ * @file	neat\Network.hpp.
+ *
+ * @brief	Declares the compiled network of a topology-evolving genome.
+ */
+#ifndef NEAT_NETWORK_H
+#define NEAT_NETWORK_H
+
+#include <vector>
+
+#include "../Params.hpp"
+#include "Genome.hpp"
+
+namespace etunn
+{
+	namespace neat
+	{
+		/**
+		 * @class	Network
+		 *
+		 * @brief	A sparse network compiled from a genome for evaluation.
+		 * 			Nodes are evaluated in topological order, each one reading its incoming
+		 * 			connections from a compressed row. Disabled connections and nodes that
+		 * 			cannot influence an output are left out.
+		 */
+		class Network
+		{
+		public:
+
+			/**
+			 * @fn	Network::Network(const Genome &genome);
+			 *
+			 * @brief	Compiles a genome.
+			 *
+			 * @param	genome	The genome.
+			 */
+			Network(const Genome &genome);
+
+			/**
+			 * @fn	std::vector<double> Network::update(const std::vector<double> &inputs, Params p);
+			 *
+			 * @brief	Calculates the outputs from a set of inputs.
+			 *
+			 * @param	inputs	The inputs.
+			 * @param	p	  	Variable arguments providing additional information.
+			 *
+			 * @return	The output of the network, or an empty vector if the amount of inputs is wrong.
+			 */
+			std::vector<double> update(const std::vector<double> &inputs, Params p);
+
+			/**
+			 * @fn	int Network::getNumberOfConnections() const;
+			 *
+			 * @brief	Gets the number of connections that are actually evaluated.
+			 *
+			 * @return	The number of connections.
+			 */
+			int getNumberOfConnections() const;
+
+		private:
+			int numInputs;
+
+			/** @brief	Index into sources/weights where the incoming connections of each evaluated node start. */
+			std::vector<int> rowStart;
+
+			/** @brief	The value slot of the source of each connection. */
+			std::vector<int> sources;
+
+			/** @brief	The weight of each connection. */
+			std::vector<double> weights;
+
+			/** @brief	The value slot of each output. */
+			std::vector<int> outputSlots;
+
+			/** @brief	Values of the inputs, the bias and every evaluated node (in that order). */
+			std::vector<double> values;
+		};
+	}
+}
+
+#endif
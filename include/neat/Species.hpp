@@ -0,0 +1,47 @@
+/**
+ * @file	neat\Species.hpp.
+ *
+ * @brief	Declares the species struct.
+ */
+#ifndef NEAT_SPECIES_H
+#define NEAT_SPECIES_H
+
+#include <vector>
+#include "Genome.hpp"
+
+namespace etunn
+{
+	namespace neat
+	{
+		/**
+		 * @struct	Species
+		 *
+		 * @brief	A group of structurally similar genomes that only compete among themselves.
+		 */
+		struct Species
+		{
+			/** @brief	The genome new members are compared against. */
+			Genome representative;
+
+			/** @brief	Indices of the members in the current population. */
+			std::vector<int> members;
+
+			/** @brief	The best fitness this species has ever reached. */
+			double bestFitness;
+
+			/** @brief	Number of generations since the best fitness improved. */
+			int staleness;
+
+			/**
+			 * @fn	Species(const Genome &representative)
+			 *
+			 * @brief	Constructor.
+			 *
+			 * @param	representative	The first member.
+			 */
+			Species(const Genome &representative) : representative(representative), bestFitness(0), staleness(0) {}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,24 @@
+/**
+ * @file	Activation.cpp.
+ *
+ * @brief	Implements the activation functions.
+ */
+#include "../include/Activation.hpp"
+
+namespace etunn
+{
+	std::string activationName(Activation function)
+	{
+		switch (function)
+		{
+		case Activation::Tanh:
+			return "tanh";
+		case Activation::ReLU:
+			return "relu";
+		case Activation::Linear:
+			return "linear";
+		default:
+			return "sigmoid";
+		}
+	}
+}
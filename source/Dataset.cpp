@@ -0,0 +1,586 @@
+/**
+ * @file	Dataset.cpp.
+ *
+ * @brief	Implements the streaming dataset reader.
+ */
+#include "../include/Dataset.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace etunn
+{
+	namespace
+	{
+		//Powers of ten that are exact as doubles
+		const double exactPowers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+		const std::size_t pageSize = 4096;
+
+		bool isDigit(char c)
+		{
+			return c >= '0' && c <= '9';
+		}
+
+		bool isBlank(char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+
+		bool isSeparator(char c)
+		{
+			return c == ',' || c == ';' || c == '\t';
+		}
+
+		//Parses a number between p and end, returns the position after it or nullptr if there is none
+		const char* parseNumber(const char *p, const char *end, double &value)
+		{
+			const char *start = p;
+			bool negative = false;
+
+			if (p < end && (*p == '-' || *p == '+'))
+			{
+				negative = *p == '-';
+				++p;
+			}
+
+			unsigned long long mantissa = 0;
+			int digits = 0, exponent = 0;
+			bool any = false;
+
+			for (; p < end && isDigit(*p); ++p, any = true)
+			{
+				if (digits < 19)
+				{
+					mantissa = mantissa * 10 + (*p - '0');
+					digits += mantissa != 0;
+				}
+				else
+				{
+					++exponent;
+				}
+			}
+
+			if (p < end && *p == '.')
+			{
+				for (++p; p < end && isDigit(*p); ++p, any = true)
+				{
+					if (digits < 19)
+					{
+						mantissa = mantissa * 10 + (*p - '0');
+						digits += mantissa != 0;
+						--exponent;
+					}
+				}
+			}
+
+			if (!any)
+			{
+				return nullptr;
+			}
+
+			if (p < end && (*p == 'e' || *p == 'E'))
+			{
+				const char *q = p + 1;
+				bool negativeExponent = false;
+
+				if (q < end && (*q == '-' || *q == '+'))
+				{
+					negativeExponent = *q == '-';
+					++q;
+				}
+
+				if (q < end && isDigit(*q))
+				{
+					int e = 0;
+
+					for (; q < end && isDigit(*q); ++q)
+					{
+						e = e < 10000 ? e * 10 + (*q - '0') : e;
+					}
+
+					exponent += negativeExponent ? -e : e;
+					p = q;
+				}
+			}
+
+			//Exact (correctly rounded) when the mantissa and the power of ten are both exact doubles
+			if (mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22)
+			{
+				value = exponent < 0 ? mantissa / exactPowers[-exponent] : mantissa * exactPowers[exponent];
+				value = negative ? -value : value;
+
+				return p;
+			}
+
+			//Rare cases go through the C library
+			char buffer[64];
+			std::size_t length = p - start;
+
+			if (length >= sizeof(buffer))
+			{
+				return nullptr;
+			}
+
+			std::memcpy(buffer, start, length);
+			buffer[length] = 0;
+			value = std::strtod(buffer, nullptr);
+
+			return p;
+		}
+	}
+
+	DatasetReader::DatasetReader()
+		: format(DatasetFormat::Binary),
+		numInputs(0),
+		numTargets(0),
+		batchSize(0),
+		prefetch(false),
+		mapping(nullptr),
+		mappingSize(0),
+		fileHandle(nullptr),
+		mappingHandle(nullptr),
+		dataStart(0),
+		cursor(0),
+		skippedRows(0),
+		produceSlot(0),
+		consumeSlot(0),
+		handedOut(false),
+		producerDone(false),
+		stopping(false)
+	{
+	}
+
+	DatasetReader::~DatasetReader()
+	{
+		close();
+	}
+
+	bool DatasetReader::open(const std::string &path, DatasetFormat format, int numInputs, int numTargets, int batchSize, bool prefetch)
+	{
+		close();
+
+		if (numInputs < 1 || numTargets < 0 || batchSize < 1)
+		{
+			return false;
+		}
+
+		this->format = format;
+		this->numInputs = numInputs;
+		this->numTargets = numTargets;
+		this->batchSize = batchSize;
+		this->prefetch = prefetch;
+
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER size;
+
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		fileHandle = file;
+		mappingSize = (std::size_t)size.QuadPart;
+
+		if (mappingSize > 0)
+		{
+			HANDLE fileMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+			if (!fileMapping)
+			{
+				close();
+				return false;
+			}
+
+			mappingHandle = fileMapping;
+			mapping = (const char *)MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+		}
+#else
+		int file = ::open(path.c_str(), O_RDONLY);
+
+		if (file < 0)
+		{
+			return false;
+		}
+
+		struct stat status;
+
+		if (fstat(file, &status) != 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		mappingSize = (std::size_t)status.st_size;
+
+		if (mappingSize > 0)
+		{
+			void *view = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, file, 0);
+			mapping = view == MAP_FAILED ? nullptr : (const char *)view;
+
+			if (mapping)
+			{
+				madvise(view, mappingSize, MADV_SEQUENTIAL);
+			}
+		}
+
+		//The mapping stays valid without the descriptor
+		::close(file);
+#endif
+
+		if (mappingSize > 0 && !mapping)
+		{
+			close();
+			return false;
+		}
+
+		dataStart = 0;
+
+		if (format == DatasetFormat::Binary)
+		{
+			//Rows are read in place, so they have to be complete
+			if (mappingSize % (sizeof(double) * (numInputs + numTargets)))
+			{
+				close();
+				return false;
+			}
+		}
+		else
+		{
+			//Skip a header line
+			const char *p = mapping, *end = mapping + mappingSize;
+
+			while (p < end && isBlank(*p))
+			{
+				++p;
+			}
+
+			if (p < end && !isDigit(*p) && *p != '-' && *p != '+' && *p != '.')
+			{
+				while (p < end && *p != '\n')
+				{
+					++p;
+				}
+
+				dataStart = p - mapping;
+			}
+		}
+
+		start();
+
+		return true;
+	}
+
+	void DatasetReader::close()
+	{
+		stop();
+
+#if defined(_WIN32)
+		if (mapping)
+		{
+			UnmapViewOfFile(mapping);
+		}
+
+		if (mappingHandle)
+		{
+			CloseHandle(mappingHandle);
+		}
+
+		if (fileHandle)
+		{
+			CloseHandle(fileHandle);
+		}
+#else
+		if (mapping)
+		{
+			munmap((void *)mapping, mappingSize);
+		}
+#endif
+
+		mapping = nullptr;
+		mappingSize = 0;
+		fileHandle = nullptr;
+		mappingHandle = nullptr;
+		batchSize = 0;
+		skippedRows = 0;
+		slots[0] = slots[1] = Slot();
+	}
+
+	bool DatasetReader::isOpen() const
+	{
+		return batchSize > 0;
+	}
+
+	bool DatasetReader::next(Batch &batch)
+	{
+		if (!isOpen())
+		{
+			return false;
+		}
+
+		Slot *slot;
+
+		if (!prefetch)
+		{
+			slot = &slots[0];
+			produce(*slot);
+		}
+		else
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+
+			//Hand the previous batch back to the prefetch thread
+			if (handedOut)
+			{
+				slots[consumeSlot].ready = false;
+				consumeSlot ^= 1;
+				handedOut = false;
+				condition.notify_all();
+			}
+
+			condition.wait(lock, [this]() { return slots[consumeSlot].ready; });
+
+			slot = &slots[consumeSlot];
+
+			//The end stays ready, so every further call returns false
+			handedOut = slot->numRows > 0;
+		}
+
+		if (slot->numRows == 0)
+		{
+			return false;
+		}
+
+		batch.data = slot->data;
+		batch.numRows = slot->numRows;
+		batch.numInputs = numInputs;
+		batch.numTargets = numTargets;
+
+		return true;
+	}
+
+	void DatasetReader::rewind()
+	{
+		if (isOpen())
+		{
+			stop();
+			start();
+		}
+	}
+
+	long long DatasetReader::getNumRows() const
+	{
+		if (format != DatasetFormat::Binary)
+		{
+			return -1;
+		}
+
+		return mappingSize / (sizeof(double) * (numInputs + numTargets));
+	}
+
+	long long DatasetReader::getNumSkippedRows() const
+	{
+		return skippedRows;
+	}
+
+	void DatasetReader::produce(Slot &slot)
+	{
+		if (format == DatasetFormat::CSV)
+		{
+			parseCSV(slot);
+			return;
+		}
+
+		std::size_t rowSize = sizeof(double) * (numInputs + numTargets);
+		std::size_t rows = (mappingSize - cursor) / rowSize;
+
+		slot.numRows = rows < (std::size_t)batchSize ? (int)rows : batchSize;
+		slot.data = (const double *)(mapping + cursor);
+
+		std::size_t end = cursor + slot.numRows * rowSize;
+
+		//Fault the pages in ahead of their use
+		if (prefetch)
+		{
+			volatile char sink = 0;
+
+			for (std::size_t p = cursor; p < end; p += pageSize)
+			{
+				sink = sink + mapping[p];
+			}
+		}
+
+		cursor = end;
+	}
+
+	void DatasetReader::parseCSV(Slot &slot)
+	{
+		int numColumns = numInputs + numTargets;
+		const char *p = mapping + cursor, *end = mapping + mappingSize;
+
+		slot.values.resize((std::size_t)batchSize * numColumns);
+		slot.numRows = 0;
+
+		while (slot.numRows < batchSize && p < end)
+		{
+			double *row = &slot.values[(std::size_t)slot.numRows * numColumns];
+			const char *lineStart = p;
+			bool valid = true;
+
+			for (int c = 0; c < numColumns && valid; ++c)
+			{
+				while (p < end && isBlank(*p))
+				{
+					++p;
+				}
+
+				const char *after = parseNumber(p, end, row[c]);
+
+				if (!after)
+				{
+					valid = false;
+					break;
+				}
+
+				p = after;
+
+				while (p < end && *p == ' ')
+				{
+					++p;
+				}
+
+				if (c + 1 < numColumns)
+				{
+					if (p < end && isSeparator(*p))
+					{
+						++p;
+					}
+					else
+					{
+						valid = false;
+					}
+				}
+			}
+
+			//The row has to end after the last column
+			while (p < end && isBlank(*p))
+			{
+				++p;
+			}
+
+			if (p < end && *p == '\r')
+			{
+				++p;
+			}
+
+			valid = valid && (p == end || *p == '\n');
+
+			//Skip to the next line
+			while (p < end && *p != '\n')
+			{
+				++p;
+			}
+
+			if (p < end)
+			{
+				++p;
+			}
+
+			if (valid)
+			{
+				slot.numRows++;
+			}
+			else
+			{
+				//Empty lines are not counted as malformed
+				const char *q = lineStart;
+
+				while (q < p && (isBlank(*q) || *q == '\r' || *q == '\n'))
+				{
+					++q;
+				}
+
+				skippedRows += q < p;
+			}
+		}
+
+		slot.data = slot.values.data();
+		cursor = p - mapping;
+	}
+
+	void DatasetReader::work()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (true)
+		{
+			condition.wait(lock, [this]() { return stopping || (!producerDone && !slots[produceSlot].ready); });
+
+			if (stopping)
+			{
+				return;
+			}
+
+			//Only this thread touches the slot and the cursor until the slot is ready
+			Slot &slot = slots[produceSlot];
+
+			lock.unlock();
+			produce(slot);
+			lock.lock();
+
+			slot.ready = true;
+			producerDone = slot.numRows == 0;
+			produceSlot ^= 1;
+			condition.notify_all();
+		}
+	}
+
+	void DatasetReader::start()
+	{
+		cursor = dataStart;
+		produceSlot = 0;
+		consumeSlot = 0;
+		handedOut = false;
+		producerDone = false;
+		stopping = false;
+		slots[0].ready = false;
+		slots[1].ready = false;
+
+		if (prefetch)
+		{
+			worker = std::thread(&DatasetReader::work, this);
+		}
+	}
+
+	void DatasetReader::stop()
+	{
+		if (worker.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+
+			condition.notify_all();
+			worker.join();
+		}
+	}
+}
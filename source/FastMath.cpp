@@ -0,0 +1,156 @@
+/**
+ * @file	FastMath.cpp.
+ *
+ * @brief	Implements the vectorized approximations of the sigmoid curve and the hyperbolic tangent.
+ */
+#include "../include/FastMath.hpp"
+#include "../include/Simd.hpp"
+
+namespace etunn
+{
+	namespace fastmath
+	{
+		const double sigmoidTable[] =
+		{
+			0.0003353501304664781, 0.0003799845147518645, 0.0004305570813246149, 0.0004878571227822659,
+			0.0005527786369235996, 0.0006263341581094202, 0.0007096703991005881, 0.0008040859356292354,
+			0.0009110511944006454, 0.0010322310367548194, 0.0011695102650555148, 0.0013250224172131609,
+			0.0015011822567369917, 0.001700722411435288, 0.0019267346633274757, 0.0021827164453451808,
+			0.0024726231566347743, 0.0028009269671209736, 0.0031726828424851893, 0.00359360258142009,
+			0.004070137715896128, 0.004609572179374208, 0.005220125693558397, 0.005911068856243796,
+			0.0066928509242848554, 0.007577241267860811, 0.008577485413711984, 0.009708476481474066,
+			0.01098694263059318, 0.01243165085318582, 0.014063627043245475, 0.015906391711814714,
+			0.01798620996209156, 0.020332353342658753, 0.022977369910025615, 0.02595735719779685,
+			0.02931223075135632, 0.033085978388704126, 0.03732688734412946, 0.042087727915618836,
+			0.04742587317756678, 0.05340332979982423, 0.060086650174007626, 0.0675466911396291,
+			0.07585818002124355, 0.08509904500702024, 0.09534946489910949, 0.10669059394565118,
+			0.11920292202211755, 0.13296424019782926, 0.14804719803168948, 0.16451646289656316,
+			0.18242552380635635, 0.20181322226037884, 0.22270013882530884, 0.24508501313237172,
+			0.2689414213699951, 0.29421497216298875, 0.320821300824607, 0.34864513533394575,
+			0.3775406687981454, 0.40733340004593027, 0.43782349911420193, 0.46879062662624377,
+			0.5, 0.5312093733737563, 0.5621765008857981, 0.5926665999540697,
+			0.6224593312018546, 0.6513548646660542, 0.679178699175393, 0.7057850278370112,
+			0.7310585786300049, 0.7549149868676283, 0.7772998611746911, 0.7981867777396212,
+			0.8175744761936437, 0.8354835371034369, 0.8519528019683106, 0.8670357598021706,
+			0.8807970779778823, 0.8933094060543487, 0.9046505351008906, 0.9149009549929797,
+			0.9241418199787566, 0.9324533088603709, 0.9399133498259924, 0.9465966702001757,
+			0.9525741268224334, 0.9579122720843811, 0.9626731126558706, 0.9669140216112958,
+			0.9706877692486436, 0.9740426428022031, 0.9770226300899744, 0.9796676466573412,
+			0.9820137900379085, 0.9840936082881853, 0.9859363729567544, 0.9875683491468141,
+			0.9890130573694068, 0.9902915235185259, 0.991422514586288, 0.9924227587321393,
+			0.9933071490757153, 0.9940889311437562, 0.9947798743064417, 0.9953904278206259,
+			0.995929862284104, 0.9964063974185798, 0.9968273171575148, 0.9971990730328789,
+			0.9975273768433653, 0.9978172835546547, 0.9980732653366725, 0.9982992775885648,
+			0.998498817743263, 0.9986749775827868, 0.9988304897349445, 0.9989677689632452,
+			0.9990889488055994, 0.9991959140643708, 0.9992903296008995, 0.9993736658418905,
+			0.9994472213630764, 0.9995121428772178, 0.9995694429186754, 0.999620015485248,
+			0.9996646498695336, 0.9996646498695336
+		};
+	}
+
+	namespace
+	{
+		using namespace simd;
+
+		//fastmath::polynomialExp() on a pack
+		inline Pack polynomialExp(Pack x)
+		{
+			const Pack shifter = broadcast(6755399441055744.0);
+
+			//The bound comes first: min and max return their second operand for NaN, which must propagate
+			x = minimum(broadcast(708), maximum(broadcast(-708), x));
+
+			Pack t = add(mul(x, broadcast(1.4426950408889634)), shifter);
+			Pack n = sub(t, shifter);
+			Pack r = sub(sub(x, mul(n, broadcast(0.6931471803691238))), mul(n, broadcast(1.9082149292705877e-10)));
+
+			Pack r2 = mul(r, r);
+			Pack high = add(broadcast(1.0 / 24), mul(r, broadcast(1.0 / 120)));
+			Pack middle = add(broadcast(0.5), mul(r, broadcast(1.0 / 6)));
+			Pack p = add(add(broadcast(1), r), mul(r2, add(middle, mul(r2, high))));
+
+			return mul(p, exponent(t));
+		}
+
+		//outputs = scale / (1 + e^(factor * inputs / divisor)) - offset, rounded like the scalar versions
+		void polynomialCurve(const double *inputs, double *outputs, int count, double divisor, double factor, double scale, double offset)
+		{
+			Pack d = broadcast(divisor), f = broadcast(factor), s = broadcast(scale), o = broadcast(offset), one = broadcast(1);
+			bool scaled = divisor != 1;
+			int k = 0;
+
+			for (; k + packSize <= count; k += packSize)
+			{
+				//Dividing by 1 changes nothing, so skip the slow division
+				Pack x = scaled ? divide(load(inputs + k), d) : load(inputs + k);
+				Pack e = polynomialExp(mul(f, x));
+				store(outputs + k, sub(divide(s, add(one, e)), o));
+			}
+
+			for (; k < count; ++k)
+			{
+				outputs[k] = scale / (1 + fastmath::polynomialExp(factor * (inputs[k] / divisor))) - offset;
+			}
+		}
+	}
+
+	std::string mathAccuracyName(MathAccuracy accuracy)
+	{
+		switch (accuracy)
+		{
+		case MathAccuracy::Polynomial:
+			return "polynomial";
+		case MathAccuracy::Table:
+			return "table";
+		default:
+			return "exact";
+		}
+	}
+
+	namespace fastmath
+	{
+		void sigmoid(MathAccuracy accuracy, const double *inputs, double *outputs, int count, double response)
+		{
+			switch (accuracy)
+			{
+			case MathAccuracy::Polynomial:
+				polynomialCurve(inputs, outputs, count, response, -1, 1, 0);
+				break;
+			case MathAccuracy::Table:
+				for (int k = 0; k < count; ++k)
+				{
+					outputs[k] = tableSigmoid(inputs[k] / response);
+				}
+				break;
+			default:
+				for (int k = 0; k < count; ++k)
+				{
+					outputs[k] = 1 / (1 + std::exp(-inputs[k] / response));
+				}
+				break;
+			}
+		}
+
+		void tanh(MathAccuracy accuracy, const double *inputs, double *outputs, int count)
+		{
+			switch (accuracy)
+			{
+			case MathAccuracy::Polynomial:
+				polynomialCurve(inputs, outputs, count, 1, -2, 2, 1);
+				break;
+			case MathAccuracy::Table:
+				for (int k = 0; k < count; ++k)
+				{
+					outputs[k] = tanh<MathAccuracy::Table>(inputs[k]);
+				}
+				break;
+			default:
+				for (int k = 0; k < count; ++k)
+				{
+					outputs[k] = std::tanh(inputs[k]);
+				}
+				break;
+			}
+		}
+	}
+}
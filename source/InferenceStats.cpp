@@ -0,0 +1,261 @@
+/**
+ * @file	InferenceStats.cpp.
+ *
+ * @brief	Implements the latency histogram and the inference statistics of the neural nets.
+ */
+#include "../include/InferenceStats.hpp"
+#include <cstdio>
+
+namespace etunn
+{
+	LatencyHistogram::LatencyHistogram()
+	{
+		reset();
+	}
+
+	LatencyHistogram::LatencyHistogram(const LatencyHistogram &other)
+	{
+		*this = other;
+	}
+
+	LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram &other)
+	{
+		for (int i = 0; i < numBuckets; ++i)
+		{
+			buckets[i].store(other.buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		total.store(other.total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		max.store(other.max.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+		return *this;
+	}
+
+	void LatencyHistogram::record(long long nanoseconds)
+	{
+		if (nanoseconds < 0)
+		{
+			nanoseconds = 0;
+		}
+
+		buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+		count.fetch_add(1, std::memory_order_relaxed);
+		total.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+		long long currentMax = max.load(std::memory_order_relaxed);
+
+		while (nanoseconds > currentMax &&
+			!max.compare_exchange_weak(currentMax, nanoseconds, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	long long LatencyHistogram::getCount() const
+	{
+		return count.load(std::memory_order_relaxed);
+	}
+
+	double LatencyHistogram::getMean() const
+	{
+		long long n = getCount();
+
+		return n ? (double)total.load(std::memory_order_relaxed) / n : 0;
+	}
+
+	long long LatencyHistogram::getMax() const
+	{
+		return max.load(std::memory_order_relaxed);
+	}
+
+	long long LatencyHistogram::getPercentile(double percentile) const
+	{
+		long long n = getCount();
+
+		if (!n)
+		{
+			return 0;
+		}
+
+		//Number of calls that have to be at or below the result
+		long long rank = (long long)(percentile / 100 * n + 0.5);
+		rank = rank < 1 ? 1 : (rank > n ? n : rank);
+
+		long long seen = 0;
+
+		for (int i = 0; i < numBuckets; ++i)
+		{
+			seen += buckets[i].load(std::memory_order_relaxed);
+
+			if (seen >= rank)
+			{
+				//Never report more than was actually recorded
+				long long upper = bucketUpperBound(i);
+				return upper < getMax() ? upper : getMax();
+			}
+		}
+
+		return getMax();
+	}
+
+	void LatencyHistogram::reset()
+	{
+		for (int i = 0; i < numBuckets; ++i)
+		{
+			buckets[i].store(0, std::memory_order_relaxed);
+		}
+
+		count.store(0, std::memory_order_relaxed);
+		total.store(0, std::memory_order_relaxed);
+		max.store(0, std::memory_order_relaxed);
+	}
+
+	int LatencyHistogram::bucketIndex(long long nanoseconds)
+	{
+		if (nanoseconds < subBucketCount)
+		{
+			return (int)nanoseconds;
+		}
+
+		if (nanoseconds >= (1LL << maxExponent))
+		{
+			nanoseconds = (1LL << maxExponent) - 1;
+		}
+
+		//Position of the highest set bit
+		int exponent = subBucketBits;
+
+		while ((nanoseconds >> (exponent + 1)) != 0)
+		{
+			++exponent;
+		}
+
+		//The bits below the highest one select the bucket within the power of two
+		int shift = exponent - subBucketBits;
+
+		return (shift + 1) * subBucketCount + (int)((nanoseconds >> shift) & (subBucketCount - 1));
+	}
+
+	long long LatencyHistogram::bucketUpperBound(int index)
+	{
+		if (index < subBucketCount)
+		{
+			return index;
+		}
+
+		int shift = index / subBucketCount - 1;
+		long long lower = (long long)(subBucketCount + index % subBucketCount) << shift;
+
+		return lower + (1LL << shift) - 1;
+	}
+
+	InferenceStats::InferenceStats(int numLayers)
+		: numLayers(numLayers),
+		layerNanoseconds(new std::atomic<long long>[numLayers])
+	{
+		for (int i = 0; i < numLayers; ++i)
+		{
+			layerNanoseconds[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	InferenceStats::InferenceStats(const InferenceStats &other)
+		: numLayers(0)
+	{
+		*this = other;
+	}
+
+	InferenceStats& InferenceStats::operator=(const InferenceStats &other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		numLayers = other.numLayers;
+		latency = other.latency;
+		layerNanoseconds.reset(new std::atomic<long long>[numLayers]);
+
+		for (int i = 0; i < numLayers; ++i)
+		{
+			layerNanoseconds[i].store(other.layerNanoseconds[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+
+		return *this;
+	}
+
+	void InferenceStats::recordCall(long long nanoseconds)
+	{
+		latency.record(nanoseconds);
+	}
+
+	void InferenceStats::recordLayer(int layer, long long nanoseconds)
+	{
+		if (layer >= 0 && layer < numLayers)
+		{
+			layerNanoseconds[layer].fetch_add(nanoseconds, std::memory_order_relaxed);
+		}
+	}
+
+	long long InferenceStats::getCallCount() const
+	{
+		return latency.getCount();
+	}
+
+	const LatencyHistogram& InferenceStats::getLatency() const
+	{
+		return latency;
+	}
+
+	int InferenceStats::getNumLayers() const
+	{
+		return numLayers;
+	}
+
+	double InferenceStats::getLayerSeconds(int layer) const
+	{
+		if (layer < 0 || layer >= numLayers)
+		{
+			return 0;
+		}
+
+		return layerNanoseconds[layer].load(std::memory_order_relaxed) * 1e-9;
+	}
+
+	void InferenceStats::reset()
+	{
+		latency.reset();
+
+		for (int i = 0; i < numLayers; ++i)
+		{
+			layerNanoseconds[i].store(0, std::memory_order_relaxed);
+		}
+	}
+
+	std::string InferenceStats::toString() const
+	{
+		char buffer[256];
+		std::snprintf(buffer, sizeof(buffer),
+			"calls: %lld, mean: %.0f ns, p50: %lld ns, p90: %lld ns, p99: %lld ns, p99.9: %lld ns, max: %lld ns\n",
+			getCallCount(), latency.getMean(), latency.getPercentile(50), latency.getPercentile(90),
+			latency.getPercentile(99), latency.getPercentile(99.9), latency.getMax());
+
+		std::string output = buffer;
+
+		double totalSeconds = 0;
+
+		for (int i = 0; i < numLayers; ++i)
+		{
+			totalSeconds += getLayerSeconds(i);
+		}
+
+		for (int i = 0; i < numLayers; ++i)
+		{
+			std::snprintf(buffer, sizeof(buffer), "layer %d: %.6f s (%.1f%%)\n", i, getLayerSeconds(i),
+				totalSeconds > 0 ? 100 * getLayerSeconds(i) / totalSeconds : 0.0);
+			output += buffer;
+		}
+
+		return output;
+	}
+}
@@ -14,12 +14,16 @@ namespace etunn
 		loc_neuronsPerHiddenLayer = 1;
 		loc_numOutputs = 1;
 		loc_activationResponse = 1;
+		loc_mathAccuracy = MathAccuracy::Exact;
 		loc_bias = -1;
 		loc_crossoverRate = 0.7;
 		loc_mutationRate = 0.1;
 		loc_maxPerturbation = 0.3;
 		loc_numElite = 4;
 		loc_numCopiesElite = 1;
+		loc_compatibilityThreshold = 3;
+		loc_addNodeRate = 0.03;
+		loc_addConnectionRate = 0.05;
 	}
 
 	NeuralNetConfiguration& NeuralNetConfiguration::numInputs(int n)
@@ -40,6 +44,18 @@ namespace etunn
 		return *this;
 	}
 
+	NeuralNetConfiguration & NeuralNetConfiguration::hiddenLayerSizes(std::vector<int> sizes)
+	{
+		loc_hiddenLayerSizes = sizes;
+		return *this;
+	}
+
+	NeuralNetConfiguration & NeuralNetConfiguration::layerActivations(std::vector<Activation> functions)
+	{
+		loc_layerActivations = functions;
+		return *this;
+	}
+
 	NeuralNetConfiguration & NeuralNetConfiguration::numOutputs(int n)
 	{
 		loc_numOutputs = n;
@@ -52,6 +68,12 @@ namespace etunn
 		return *this;
 	}
 
+	NeuralNetConfiguration & NeuralNetConfiguration::mathAccuracy(MathAccuracy accuracy)
+	{
+		loc_mathAccuracy = accuracy;
+		return *this;
+	}
+
 	NeuralNetConfiguration & NeuralNetConfiguration::bias(double n)
 	{
 		loc_bias = n;
@@ -88,6 +110,24 @@ namespace etunn
 		return *this;
 	}
 
+	NeuralNetConfiguration & NeuralNetConfiguration::compatibilityThreshold(double n)
+	{
+		loc_compatibilityThreshold = n;
+		return *this;
+	}
+
+	NeuralNetConfiguration & NeuralNetConfiguration::addNodeRate(double n)
+	{
+		loc_addNodeRate = n;
+		return *this;
+	}
+
+	NeuralNetConfiguration & NeuralNetConfiguration::addConnectionRate(double n)
+	{
+		loc_addConnectionRate = n;
+		return *this;
+	}
+
 	std::string NeuralNetConfiguration::outputConfig()
 	{
 		std::string output = "";
@@ -95,16 +135,29 @@ namespace etunn
 		output.append("Displaying configuration...");
 
 		output.append("\n Number of input neurons: " + std::to_string(loc_numInputs));
-		output.append("\n Number of hidden layers: " + std::to_string(loc_numHidden));
-		output.append("\n Number of neurons per layer: " + std::to_string(loc_neuronsPerHiddenLayer));
-		output.append("\n Number of output neurons: " + std::to_string(loc_numOutputs));
+		output.append("\n Number of hidden layers: " + std::to_string(getNumHidden()));
+
+		std::vector<int> sizes = getHiddenLayerSizes();
+		std::vector<Activation> functions = getLayerActivations();
+
+		output.append("\n Neurons per hidden layer:");
+		for (int i = 0; i < sizes.size(); ++i)
+		{
+			output.append(" " + std::to_string(sizes[i]) + " (" + activationName(functions[i]) + ")");
+		}
+
+		output.append("\n Number of output neurons: " + std::to_string(loc_numOutputs) + " (" + activationName(functions.back()) + ")");
 		output.append("\n Activation response: " + std::to_string(loc_activationResponse));
+		output.append("\n Math accuracy: " + mathAccuracyName(loc_mathAccuracy));
 		output.append("\n Bias: " + std::to_string(loc_bias));
 		output.append("\n Crossover rate: " + std::to_string(loc_crossoverRate));
 		output.append("\n Mutation rate: " + std::to_string(loc_mutationRate));
 		output.append("\n Max. perturbation: " + std::to_string(loc_maxPerturbation));
 		output.append("\n Number of elites: " + std::to_string(loc_numElite));
 		output.append("\n Number of elite copies: " + std::to_string(loc_numCopiesElite));
+		output.append("\n Compatibility threshold: " + std::to_string(loc_compatibilityThreshold));
+		output.append("\n Add node rate: " + std::to_string(loc_addNodeRate));
+		output.append("\n Add connection rate: " + std::to_string(loc_addConnectionRate));
 
 
 		output.append("\n\n == END OF DEBUG DATA ==\n");
@@ -120,6 +173,11 @@ namespace etunn
 
 	int NeuralNetConfiguration::getNumHidden()
 	{
+		if (!loc_hiddenLayerSizes.empty())
+		{
+			return loc_hiddenLayerSizes.size();
+		}
+
 		return loc_numHidden;
 	}
 
@@ -128,6 +186,26 @@ namespace etunn
 		return loc_neuronsPerHiddenLayer;
 	}
 
+	std::vector<int> NeuralNetConfiguration::getHiddenLayerSizes()
+	{
+		if (!loc_hiddenLayerSizes.empty())
+		{
+			return loc_hiddenLayerSizes;
+		}
+
+		//Every hidden layer has the same size
+		return std::vector<int>(loc_numHidden, loc_neuronsPerHiddenLayer);
+	}
+
+	std::vector<Activation> NeuralNetConfiguration::getLayerActivations()
+	{
+		//Fill up the missing layers with the sigmoid curve
+		std::vector<Activation> functions = loc_layerActivations;
+		functions.resize(getNumHidden() + 1, Activation::Sigmoid);
+
+		return functions;
+	}
+
 	int NeuralNetConfiguration::getNumOutputs()
 	{
 		return loc_numOutputs;
@@ -138,6 +216,11 @@ namespace etunn
 		return loc_activationResponse;
 	}
 
+	MathAccuracy NeuralNetConfiguration::getMathAccuracy()
+	{
+		return loc_mathAccuracy;
+	}
+
 	double NeuralNetConfiguration::getBias()
 	{
 		return loc_bias;
@@ -167,4 +250,19 @@ namespace etunn
 	{
 		return loc_numCopiesElite;
 	}
+
+	double NeuralNetConfiguration::getCompatibilityThreshold()
+	{
+		return loc_compatibilityThreshold;
+	}
+
+	double NeuralNetConfiguration::getAddNodeRate()
+	{
+		return loc_addNodeRate;
+	}
+
+	double NeuralNetConfiguration::getAddConnectionRate()
+	{
+		return loc_addConnectionRate;
+	}
 }
\ No newline at end of file
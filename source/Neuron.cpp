@@ -4,6 +4,7 @@
  * @brief	Implements the neuron class.
  */
 #include "../include/Neuron.hpp"
+#include <cstdlib>
 
 namespace etunn
 {
@@ -18,4 +19,8 @@ namespace etunn
 			weights.push_back(rand1 - rand2);
 		}
 	};
+
+	Neuron::Neuron(const std::vector<double> &weights) : numInputs(weights.size()), weights(weights)
+	{
+	}
 }
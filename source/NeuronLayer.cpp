@@ -7,10 +7,110 @@
 
 namespace etunn
 {
-	NeuronLayer::NeuronLayer(int numNeurons, int NumInputsPerNeuron) : numNeurons(numNeurons)
+	NeuronLayer::NeuronLayer(int numNeurons, int NumInputsPerNeuron, Activation activation, MathAccuracy accuracy)
+		: numNeurons(numNeurons), activation(activation), accuracy(accuracy), numInputsPerNeuron(NumInputsPerNeuron), sparse(false)
 	{
 		for (int i = 0; i < numNeurons; ++i)
 
 			neurons.push_back(Neuron(NumInputsPerNeuron));
 	}
+
+	double NeuronLayer::getDensity() const
+	{
+		int total = numNeurons * (numInputsPerNeuron + 1);
+		int nonZero = 0;
+
+		if (total == 0)
+		{
+			return 0;
+		}
+
+		for (int j = 0; j < numNeurons; ++j)
+		{
+			std::vector<double> weights = getNeuronWeights(j);
+
+			for (int k = 0; k < weights.size(); ++k)
+			{
+				if (weights[k] != 0)
+				{
+					nonZero++;
+				}
+			}
+		}
+
+		return (double)nonZero / total;
+	}
+
+	std::vector<double> NeuronLayer::getNeuronWeights(int neuron) const
+	{
+		if (!sparse)
+		{
+			return neurons[neuron].weights;
+		}
+
+		std::vector<double> weights(numInputsPerNeuron + 1, 0);
+
+		for (int e = rowStart[neuron]; e < rowStart[neuron + 1]; ++e)
+		{
+			weights[columns[e]] = values[e];
+		}
+
+		weights[numInputsPerNeuron] = biasWeights[neuron];
+
+		return weights;
+	}
+
+	void NeuronLayer::compress()
+	{
+		if (sparse)
+		{
+			return;
+		}
+
+		rowStart.clear();
+		columns.clear();
+		values.clear();
+		biasWeights.clear();
+
+		for (int j = 0; j < numNeurons; ++j)
+		{
+			rowStart.push_back(columns.size());
+
+			for (int k = 0; k < numInputsPerNeuron; ++k)
+			{
+				if (neurons[j].weights[k] != 0)
+				{
+					columns.push_back(k);
+					values.push_back(neurons[j].weights[k]);
+				}
+			}
+
+			biasWeights.push_back(neurons[j].weights[numInputsPerNeuron]);
+		}
+
+		rowStart.push_back(columns.size());
+
+		//Release the dense weights
+		std::vector<Neuron>().swap(neurons);
+		sparse = true;
+	}
+
+	void NeuronLayer::decompress()
+	{
+		if (!sparse)
+		{
+			return;
+		}
+
+		for (int j = 0; j < numNeurons; ++j)
+		{
+			neurons.push_back(Neuron(getNeuronWeights(j)));
+		}
+
+		std::vector<int>().swap(rowStart);
+		std::vector<int>().swap(columns);
+		std::vector<double>().swap(values);
+		std::vector<double>().swap(biasWeights);
+		sparse = false;
+	}
 }
\ No newline at end of file
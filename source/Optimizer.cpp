@@ -0,0 +1,244 @@
+/**
+ * @file	Optimizer.cpp.
+ *
+ * @brief	Implements the gradient descent optimizers.
+ */
+#include "../include/Optimizer.hpp"
+#include <cmath>
+#include <sstream>
+
+#include "../include/Simd.hpp"
+
+namespace etunn
+{
+	namespace
+	{
+		using namespace simd;
+
+		//w -= rate * g
+		void applySGD(double *w, const double *g, int n, double rate)
+		{
+			Pack r = broadcast(rate);
+			int k = 0;
+
+			for (; k + packSize <= n; k += packSize)
+			{
+				store(w + k, sub(load(w + k), mul(r, load(g + k))));
+			}
+
+			for (; k < n; ++k)
+			{
+				w[k] -= rate * g[k];
+			}
+		}
+
+		//v = momentum * v - rate * g, w += v
+		void applyMomentum(double *w, const double *g, double *v, int n, double rate, double mu)
+		{
+			Pack r = broadcast(rate), m = broadcast(mu);
+			int k = 0;
+
+			for (; k + packSize <= n; k += packSize)
+			{
+				Pack velocity = sub(mul(m, load(v + k)), mul(r, load(g + k)));
+				store(v + k, velocity);
+				store(w + k, add(load(w + k), velocity));
+			}
+
+			for (; k < n; ++k)
+			{
+				v[k] = mu * v[k] - rate * g[k];
+				w[k] += v[k];
+			}
+		}
+
+		//s = decay * s + (1 - decay) * g^2, w -= rate * g / (sqrt(s) + epsilon)
+		void applyRMSProp(double *w, const double *g, double *s, int n, double rate, double rho, double eps)
+		{
+			Pack r = broadcast(rate), d = broadcast(rho), d1 = broadcast(1 - rho), e = broadcast(eps);
+			int k = 0;
+
+			for (; k + packSize <= n; k += packSize)
+			{
+				Pack gradient = load(g + k);
+				Pack square = add(mul(d, load(s + k)), mul(d1, mul(gradient, gradient)));
+				store(s + k, square);
+				store(w + k, sub(load(w + k), divide(mul(r, gradient), add(root(square), e))));
+			}
+
+			for (; k < n; ++k)
+			{
+				s[k] = rho * s[k] + (1 - rho) * g[k] * g[k];
+				w[k] -= rate * g[k] / (std::sqrt(s[k]) + eps);
+			}
+		}
+
+		//m = beta1 * m + (1 - beta1) * g, v = beta2 * v + (1 - beta2) * g^2,
+		//w -= rate * (m * c1) / (sqrt(v * c2) + epsilon) with the bias corrections c1 and c2
+		void applyAdam(double *w, const double *g, double *m, double *v, int n, double rate,
+			double b1, double b2, double eps, double c1, double c2)
+		{
+			Pack r = broadcast(rate * c1), e = broadcast(eps), c = broadcast(c2);
+			Pack beta1 = broadcast(b1), beta1c = broadcast(1 - b1);
+			Pack beta2 = broadcast(b2), beta2c = broadcast(1 - b2);
+			int k = 0;
+
+			for (; k + packSize <= n; k += packSize)
+			{
+				Pack gradient = load(g + k);
+				Pack mean = add(mul(beta1, load(m + k)), mul(beta1c, gradient));
+				Pack square = add(mul(beta2, load(v + k)), mul(beta2c, mul(gradient, gradient)));
+				store(m + k, mean);
+				store(v + k, square);
+				store(w + k, sub(load(w + k), divide(mul(r, mean), add(root(mul(square, c)), e))));
+			}
+
+			for (; k < n; ++k)
+			{
+				m[k] = b1 * m[k] + (1 - b1) * g[k];
+				v[k] = b2 * v[k] + (1 - b2) * g[k] * g[k];
+				w[k] -= rate * c1 * m[k] / (std::sqrt(v[k] * c2) + eps);
+			}
+		}
+	}
+
+	Optimizer::Optimizer(OptimizerType type, double learningRate)
+		: type(type), rate(learningRate), momentumFactor(0.9), decayFactor(0.9),
+		beta1Factor(0.9), beta2Factor(0.999), epsilonTerm(1e-8), step(0), correction1(1), correction2(1)
+	{
+		//Do nothing
+	}
+
+	Optimizer& Optimizer::learningRate(double learningRate)
+	{
+		rate = learningRate;
+		return *this;
+	}
+
+	Optimizer& Optimizer::momentum(double momentum)
+	{
+		momentumFactor = momentum;
+		return *this;
+	}
+
+	Optimizer& Optimizer::decay(double decay)
+	{
+		decayFactor = decay;
+		return *this;
+	}
+
+	Optimizer& Optimizer::beta1(double beta1)
+	{
+		beta1Factor = beta1;
+		return *this;
+	}
+
+	Optimizer& Optimizer::beta2(double beta2)
+	{
+		beta2Factor = beta2;
+		return *this;
+	}
+
+	Optimizer& Optimizer::epsilon(double epsilon)
+	{
+		epsilonTerm = epsilon;
+		return *this;
+	}
+
+	void Optimizer::reset(int numWeights)
+	{
+		step = 0;
+		correction1 = correction2 = 1;
+
+		first.assign(type == OptimizerType::SGD ? 0 : numWeights, 0.0);
+		second.assign(type == OptimizerType::Adam ? numWeights : 0, 0.0);
+	}
+
+	void Optimizer::nextStep()
+	{
+		step++;
+
+		if (type == OptimizerType::Adam)
+		{
+			correction1 = 1 / (1 - std::pow(beta1Factor, step));
+			correction2 = 1 / (1 - std::pow(beta2Factor, step));
+		}
+	}
+
+	void Optimizer::apply(double *weights, const double *gradients, int offset, int count)
+	{
+		//Grow the state if the net has more weights than the optimizer was set up for
+		if (type != OptimizerType::SGD && first.size() < offset + count)
+		{
+			first.resize(offset + count, 0.0);
+		}
+
+		if (type == OptimizerType::Adam && second.size() < offset + count)
+		{
+			second.resize(offset + count, 0.0);
+		}
+
+		switch (type)
+		{
+		case OptimizerType::Momentum:
+			applyMomentum(weights, gradients, first.data() + offset, count, rate, momentumFactor);
+			break;
+		case OptimizerType::RMSProp:
+			applyRMSProp(weights, gradients, first.data() + offset, count, rate, decayFactor, epsilonTerm);
+			break;
+		case OptimizerType::Adam:
+			applyAdam(weights, gradients, first.data() + offset, second.data() + offset, count, rate,
+				beta1Factor, beta2Factor, epsilonTerm, correction1, correction2);
+			break;
+		default:
+			applySGD(weights, gradients, count, rate);
+			break;
+		}
+	}
+
+	void Optimizer::apply(std::vector<double> &weights, const std::vector<double> &gradients)
+	{
+		//Ignore gradients that do not fit the weights
+		if (weights.size() != gradients.size())
+		{
+			return;
+		}
+
+		nextStep();
+		apply(weights.data(), gradients.data(), 0, weights.size());
+	}
+
+	OptimizerType Optimizer::getType() const
+	{
+		return type;
+	}
+
+	int Optimizer::getStep() const
+	{
+		return step;
+	}
+
+	std::string Optimizer::toString() const
+	{
+		std::ostringstream stream;
+
+		switch (type)
+		{
+		case OptimizerType::Momentum:
+			stream << "Momentum(rate=" << rate << ", momentum=" << momentumFactor << ")";
+			break;
+		case OptimizerType::RMSProp:
+			stream << "RMSProp(rate=" << rate << ", decay=" << decayFactor << ", epsilon=" << epsilonTerm << ")";
+			break;
+		case OptimizerType::Adam:
+			stream << "Adam(rate=" << rate << ", beta1=" << beta1Factor << ", beta2=" << beta2Factor
+				<< ", epsilon=" << epsilonTerm << ")";
+			break;
+		default:
+			stream << "SGD(rate=" << rate << ")";
+			break;
+		}
+
+		return stream.str();
+	}
+}
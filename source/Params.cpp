@@ -12,27 +12,39 @@ namespace etunn
 	int Params::numInputs = 0;
 	int Params::numHidden = 0;
 	int Params::neuronsPerHiddenLayer = 0;
+	std::vector<int> Params::hiddenLayerSizes;
+	std::vector<Activation> Params::layerActivations;
 	int Params::numOutputs = 0;
 	double Params::activationResponse = 0;
+	MathAccuracy Params::mathAccuracy = MathAccuracy::Exact;
 	double Params::bias = 0;
 	double Params::crossoverRate = 0;
 	double Params::mutationRate = 0;
 	double Params::maxPerturbation = 0;
 	int Params::numElite = 0;
 	int Params::numCopiesElite = 0;
+	double Params::compatibilityThreshold = 0;
+	double Params::addNodeRate = 0;
+	double Params::addConnectionRate = 0;
 
 	void Params::setParams(NeuralNetConfiguration config)
 	{
 		numInputs = config.getNumInputs();
 		numHidden = config.getNumHidden();
 		neuronsPerHiddenLayer = config.getNeuronsPerHiddenLayer();
+		hiddenLayerSizes = config.getHiddenLayerSizes();
+		layerActivations = config.getLayerActivations();
 		numOutputs = config.getNumOutputs();
 		activationResponse = config.getActivationResponse();
+		mathAccuracy = config.getMathAccuracy();
 		bias = config.getBias();
 		crossoverRate = config.getCrossoverRate();
 		mutationRate = config.getMutationRate();
 		maxPerturbation = config.getMaxPerturbation();
 		numElite = config.getNumElite();
 		numCopiesElite = config.getNumCopiesElite();
+		compatibilityThreshold = config.getCompatibilityThreshold();
+		addNodeRate = config.getAddNodeRate();
+		addConnectionRate = config.getAddConnectionRate();
 	}
 }
\ No newline at end of file
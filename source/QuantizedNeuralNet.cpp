@@ -0,0 +1,298 @@
+/**
+ * @file	QuantizedNeuralNet.cpp.
+ *
+ * @brief	Implements the int8 quantized neural net class.
+ */
+#include "../include/QuantizedNeuralNet.hpp"
+#include "../include/Activation.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+namespace etunn
+{
+	namespace
+	{
+		//Number of entries of each activation lookup table
+		const int tableSize = 512;
+
+		//Rows are padded to a multiple of this for the vector kernels
+		const int rowAlignment = 16;
+
+		int clamp(int value, int low, int high)
+		{
+			return value < low ? low : (value > high ? high : value);
+		}
+
+		//Sums up weights * inputs of one row, n has to be a multiple of rowAlignment
+		std::int32_t dot(const std::int8_t *weights, const std::uint8_t *inputs, int n)
+		{
+#if defined(__AVX2__)
+			__m256i sum = _mm256_setzero_si256();
+
+			for (int k = 0; k < n; k += 16)
+			{
+				//Widen to 16 bit, so the products can not saturate
+				__m256i x = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(inputs + k)));
+				__m256i w = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(weights + k)));
+				sum = _mm256_add_epi32(sum, _mm256_madd_epi16(x, w));
+			}
+
+			__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+			half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+			half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			return _mm_cvtsi128_si32(half);
+#elif defined(__SSE4_1__)
+			__m128i sum = _mm_setzero_si128();
+
+			for (int k = 0; k < n; k += 8)
+			{
+				__m128i x = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(inputs + k)));
+				__m128i w = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(weights + k)));
+				sum = _mm_add_epi32(sum, _mm_madd_epi16(x, w));
+			}
+
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			return _mm_cvtsi128_si32(sum);
+#else
+			std::int32_t sum = 0;
+
+			for (int k = 0; k < n; ++k)
+			{
+				sum += weights[k] * inputs[k];
+			}
+
+			return sum;
+#endif
+		}
+	}
+
+	QuantizedNeuralNet::QuantizedNeuralNet(const Topology &topology, const std::vector<double> &weights,
+		const std::vector<std::vector<double> > &samples, Params p)
+	{
+		//Leave the net empty if the weights do not fit the topology, update() rejects it then
+		if (weights.size() != topology.getNumberOfWeights())
+		{
+			return;
+		}
+
+		int numLayers = topology.layerSizes.size();
+
+		//The value ranges always contain zero, so zero is represented exactly
+		std::vector<double> inputMin(numLayers, 0), inputMax(numLayers, 0);
+		std::vector<double> netMin(numLayers, 0), netMax(numLayers, 0);
+
+		//Calibrate: run the samples through the full precision network and record the ranges
+		for (int s = 0; s < samples.size(); ++s)
+		{
+			if (samples[s].size() != topology.numInputs)
+			{
+				continue;
+			}
+
+			std::vector<double> inputs = samples[s];
+			int weight = 0;
+
+			for (int i = 0; i < numLayers; ++i)
+			{
+				int numInputs = topology.getLayerInputs(i);
+				std::vector<double> outputs;
+
+				for (int k = 0; k < numInputs; ++k)
+				{
+					inputMin[i] = std::min(inputMin[i], inputs[k]);
+					inputMax[i] = std::max(inputMax[i], inputs[k]);
+				}
+
+				for (int j = 0; j < topology.layerSizes[i]; ++j)
+				{
+					double netinput = 0;
+
+					for (int k = 0; k < numInputs; ++k)
+					{
+						netinput += weights[weight++] * inputs[k];
+					}
+
+					netinput += weights[weight++] * p.bias;
+
+					netMin[i] = std::min(netMin[i], netinput);
+					netMax[i] = std::max(netMax[i], netinput);
+
+					outputs.push_back(activate(topology.activations[i], netinput, p.activationResponse));
+				}
+
+				inputs = outputs;
+			}
+		}
+
+		//Input quantization of every layer
+		for (int i = 0; i < numLayers; ++i)
+		{
+			//Value-initialized, so no scalar member is left indeterminate
+			Layer layer = Layer();
+			layer.numInputs = topology.getLayerInputs(i);
+			layer.stride = (layer.numInputs + rowAlignment - 1) / rowAlignment * rowAlignment;
+			layer.numNeurons = topology.layerSizes[i];
+
+			layer.inputScale = (inputMax[i] - inputMin[i]) / 255;
+
+			if (layer.inputScale <= 0)
+			{
+				layer.inputScale = 1;
+			}
+
+			layer.inputZero = clamp((int)std::floor(-inputMin[i] / layer.inputScale + 0.5), 0, 255);
+
+			layers.push_back(layer);
+		}
+
+		int weight = 0;
+
+		for (int i = 0; i < numLayers; ++i)
+		{
+			Layer &layer = layers[i];
+
+			//One scale for all weights (without the biases) of the layer
+			double maxWeight = 0;
+			int rowLength = layer.numInputs + 1;
+
+			for (int j = 0; j < layer.numNeurons; ++j)
+			{
+				for (int k = 0; k < layer.numInputs; ++k)
+				{
+					maxWeight = std::max(maxWeight, std::fabs(weights[weight + j * rowLength + k]));
+				}
+			}
+
+			layer.weightScale = maxWeight > 0 ? maxWeight / 127 : 1;
+			layer.weights.assign(layer.numNeurons * layer.stride, 0);
+
+			for (int j = 0; j < layer.numNeurons; ++j)
+			{
+				std::int32_t rowSum = 0;
+
+				for (int k = 0; k < layer.numInputs; ++k)
+				{
+					int q = clamp((int)std::floor(weights[weight++] / layer.weightScale + 0.5), -127, 127);
+					layer.weights[j * layer.stride + k] = (std::int8_t)q;
+					rowSum += q;
+				}
+
+				layer.rowSums.push_back(rowSum);
+				layer.biasTerms.push_back((float)(weights[weight++] * p.bias));
+			}
+
+			//Activation lookup table over the calibrated range of the summed inputs
+			layer.tableMin = netMin[i];
+			layer.tableStep = (netMax[i] - netMin[i]) / (tableSize - 1);
+
+			if (layer.tableStep <= 0)
+			{
+				layer.tableStep = 1;
+			}
+
+			for (int t = 0; t < tableSize; ++t)
+			{
+				double output = activate(topology.activations[i], layer.tableMin + t * layer.tableStep, p.activationResponse);
+
+				if (i == numLayers - 1)
+				{
+					layer.outputTable.push_back(output);
+				}
+				else
+				{
+					//Quantize straight into the input format of the next layer
+					const Layer &next = layers[i + 1];
+					layer.table.push_back((std::uint8_t)clamp((int)std::floor(output / next.inputScale + 0.5) + next.inputZero, 0, 255));
+				}
+			}
+		}
+
+		int maxStride = 0;
+
+		for (int i = 0; i < numLayers; ++i)
+		{
+			maxStride = std::max(maxStride, layers[i].stride);
+		}
+
+		bufferA.assign(maxStride, 0);
+		bufferB.assign(maxStride, 0);
+	}
+
+	std::vector<double> QuantizedNeuralNet::update(const std::vector<double> &inputs)
+	{
+		std::vector<double> outputs;
+
+		//Check that the amount of inputs is correct
+		if (layers.empty() || inputs.size() != layers[0].numInputs)
+		{
+			//Return an empty vector if incorrect.
+			return outputs;
+		}
+
+		//Quantize the inputs
+		for (int k = 0; k < inputs.size(); ++k)
+		{
+			bufferA[k] = (std::uint8_t)clamp((int)std::floor(inputs[k] / layers[0].inputScale + 0.5) + layers[0].inputZero, 0, 255);
+		}
+
+		std::uint8_t *in = bufferA.data();
+		std::uint8_t *out = bufferB.data();
+
+		for (int i = 0; i < layers.size(); ++i)
+		{
+			const Layer &layer = layers[i];
+			double scale = layer.weightScale * layer.inputScale;
+			bool last = i == layers.size() - 1;
+
+			//Clear the padding the next layer reads
+			if (!last)
+			{
+				std::fill(out, out + layers[i + 1].stride, 0);
+			}
+
+			for (int j = 0; j < layer.numNeurons; ++j)
+			{
+				std::int32_t sum = dot(&layer.weights[j * layer.stride], in, layer.stride) - layer.inputZero * layer.rowSums[j];
+				double netinput = sum * scale + layer.biasTerms[j];
+
+				int t = clamp((int)((netinput - layer.tableMin) / layer.tableStep + 0.5), 0, tableSize - 1);
+
+				if (last)
+				{
+					outputs.push_back(layer.outputTable[t]);
+				}
+				else
+				{
+					out[j] = layer.table[t];
+				}
+			}
+
+			std::swap(in, out);
+		}
+
+		return outputs;
+	}
+
+	int QuantizedNeuralNet::getModelSize() const
+	{
+		int size = 0;
+
+		for (int i = 0; i < layers.size(); ++i)
+		{
+			size += layers[i].weights.size() * sizeof(std::int8_t);
+			size += layers[i].rowSums.size() * sizeof(std::int32_t);
+			size += layers[i].biasTerms.size() * sizeof(float);
+			size += layers[i].table.size() * sizeof(std::uint8_t);
+			size += layers[i].outputTable.size() * sizeof(float);
+		}
+
+		return size;
+	}
+}
@@ -0,0 +1,98 @@
+/**
+ * @file	evolutionary\EpochProfile.cpp.
+ *
+ * @brief	Implements the per-generation profile of the genetic algorithm.
+ */
+#include "../../include/evolutionary/EpochProfile.hpp"
+#include <cstdio>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		namespace
+		{
+			std::string formatSeconds(double seconds)
+			{
+				char buffer[32];
+				std::snprintf(buffer, sizeof(buffer), "%.9f", seconds);
+
+				return buffer;
+			}
+		}
+
+		const char* epochPhaseName(EpochPhase phase)
+		{
+			switch (phase)
+			{
+			case EpochPhase::Copy:
+				return "copy";
+			case EpochPhase::Sort:
+				return "sort";
+			case EpochPhase::Statistics:
+				return "statistics";
+			case EpochPhase::Selection:
+				return "selection";
+			case EpochPhase::Crossover:
+				return "crossover";
+			case EpochPhase::Mutation:
+				return "mutation";
+			default:
+				return "unknown";
+			}
+		}
+
+		std::string profilesToCSV(const std::vector<EpochProfile> &profiles)
+		{
+			std::string output = "generation";
+
+			for (int i = 0; i < numEpochPhases; ++i)
+			{
+				output.append(std::string(",") + epochPhaseName((EpochPhase)i) + "_seconds");
+				output.append(std::string(",") + epochPhaseName((EpochPhase)i) + "_allocations");
+			}
+
+			output.append("\n");
+
+			for (int g = 0; g < profiles.size(); ++g)
+			{
+				output.append(std::to_string(profiles[g].generation));
+
+				for (int i = 0; i < numEpochPhases; ++i)
+				{
+					output.append("," + formatSeconds(profiles[g].seconds[i]));
+					output.append("," + std::to_string(profiles[g].allocations[i]));
+				}
+
+				output.append("\n");
+			}
+
+			return output;
+		}
+
+		std::string profilesToJSON(const std::vector<EpochProfile> &profiles)
+		{
+			std::string output = "[";
+
+			for (int g = 0; g < profiles.size(); ++g)
+			{
+				output.append(g ? ",\n" : "\n");
+				output.append("  {\"generation\": " + std::to_string(profiles[g].generation));
+
+				for (int i = 0; i < numEpochPhases; ++i)
+				{
+					std::string name = epochPhaseName((EpochPhase)i);
+
+					output.append(", \"" + name + "_seconds\": " + formatSeconds(profiles[g].seconds[i]));
+					output.append(", \"" + name + "_allocations\": " + std::to_string(profiles[g].allocations[i]));
+				}
+
+				output.append("}");
+			}
+
+			output.append("\n]\n");
+
+			return output;
+		}
+	}
+}
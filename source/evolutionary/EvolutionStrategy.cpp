@@ -0,0 +1,302 @@
+/**
+ * @file	evolutionary\EvolutionStrategy.cpp.
+ *
+ * @brief	Implements the evolution strategy class.
+ */
+#include "../../include/evolutionary/EvolutionStrategy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <thread>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		namespace
+		{
+			const double pi = 3.14159265358979323846;
+
+			//SplitMix64: fast, and every seed gives an independent looking stream
+			inline std::uint64_t nextRandom(std::uint64_t &state)
+			{
+				std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				return z ^ (z >> 31);
+			}
+
+			//Uniform in (0, 1], so the logarithm below is finite
+			inline double nextUniform(std::uint64_t &state)
+			{
+				return ((nextRandom(state) >> 11) + 1) * (1.0 / 9007199254740992.0);
+			}
+
+			int countThreads(int numThreads, int numTasks)
+			{
+				if (numThreads <= 0)
+				{
+					numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+				}
+
+				return std::max(1, std::min(numThreads, numTasks));
+			}
+
+			//Runs work(thread) on numThreads threads, the calling thread being thread 0
+			template<typename F>
+			void runThreads(int numThreads, F work)
+			{
+				std::vector<std::thread> workers;
+
+				for (int t = 1; t < numThreads; ++t)
+				{
+					workers.push_back(std::thread(work, t));
+				}
+
+				work(0);
+
+				for (int t = 0; t < workers.size(); ++t)
+				{
+					workers[t].join();
+				}
+			}
+		}
+
+		EvolutionStrategy::EvolutionStrategy(const std::vector<double> &weights, int numPairs, double sigma, const Optimizer &optimizer)
+			: center(weights),
+			numPairs(std::max(1, numPairs)),
+			sigma(sigma),
+			optimizer(optimizer),
+			generation(0),
+			averageFitness(0),
+			bestFitness(0),
+			bestWeights(weights)
+		{
+			seedState = ((std::uint64_t)rand() << 32) ^ (std::uint64_t)rand();
+
+			this->optimizer.reset(center.size());
+			drawSeeds();
+		}
+
+		void EvolutionStrategy::drawSeeds()
+		{
+			seeds.resize(numPairs);
+
+			for (int i = 0; i < numPairs; ++i)
+			{
+				seeds[i] = nextRandom(seedState);
+			}
+		}
+
+		void EvolutionStrategy::generateNoise(std::uint64_t seed, double *noise, int count)
+		{
+			std::uint64_t state = seed;
+			int k = 0;
+
+			//Box-Muller, two values per pair of uniforms
+			for (; k + 1 < count; k += 2)
+			{
+				double radius = std::sqrt(-2 * std::log(nextUniform(state)));
+				double angle = 2 * pi * nextUniform(state);
+
+				noise[k] = radius * std::cos(angle);
+				noise[k + 1] = radius * std::sin(angle);
+			}
+
+			if (k < count)
+			{
+				double radius = std::sqrt(-2 * std::log(nextUniform(state)));
+				noise[k] = radius * std::cos(2 * pi * nextUniform(state));
+			}
+		}
+
+		void EvolutionStrategy::epoch(const FitnessFunction &fitness, int numThreads)
+		{
+			int threads = countThreads(numThreads, numPairs);
+			int numWeights = center.size();
+			std::vector<double> fitnesses(2 * numPairs);
+
+			//Every thread evaluates every threads-th pair, regenerating the noise from the seed
+			runThreads(threads, [&](int thread)
+			{
+				std::vector<double> noise(numWeights), candidate(numWeights);
+
+				for (int i = thread; i < numPairs; i += threads)
+				{
+					generateNoise(seeds[i], noise.data(), numWeights);
+
+					for (int k = 0; k < numWeights; ++k)
+					{
+						candidate[k] = center[k] + sigma * noise[k];
+					}
+
+					fitnesses[2 * i] = fitness(candidate, thread);
+
+					for (int k = 0; k < numWeights; ++k)
+					{
+						candidate[k] = center[k] - sigma * noise[k];
+					}
+
+					fitnesses[2 * i + 1] = fitness(candidate, thread);
+				}
+			});
+
+			tell(fitnesses, numThreads);
+		}
+
+		const std::vector<std::uint64_t>& EvolutionStrategy::getSeeds() const
+		{
+			return seeds;
+		}
+
+		void EvolutionStrategy::getCandidate(int index, std::vector<double> &weights) const
+		{
+			int numWeights = center.size();
+			double scale = index % 2 ? -sigma : sigma;
+
+			weights.resize(numWeights);
+			generateNoise(seeds[index / 2], weights.data(), numWeights);
+
+			for (int k = 0; k < numWeights; ++k)
+			{
+				weights[k] = center[k] + scale * weights[k];
+			}
+		}
+
+		void EvolutionStrategy::tell(const std::vector<double> &fitnesses, int numThreads)
+		{
+			int popSize = 2 * numPairs;
+
+			if (fitnesses.size() != popSize)
+			{
+				return;
+			}
+
+			//A diverging net may report NaN, which has no order; rank it below every other fitness
+			std::vector<double> scores(fitnesses);
+
+			for (int i = 0; i < popSize; ++i)
+			{
+				if (scores[i] != scores[i])
+				{
+					scores[i] = -std::numeric_limits<double>::infinity();
+				}
+			}
+
+			//Statistics, taken before the center moves
+			int best = 0;
+			double total = 0;
+
+			for (int i = 0; i < popSize; ++i)
+			{
+				total += scores[i];
+
+				if (scores[i] > scores[best])
+				{
+					best = i;
+				}
+			}
+
+			averageFitness = total / popSize;
+			bestFitness = scores[best];
+			getCandidate(best, bestWeights);
+
+			//Rank based fitness shaping: the worst candidate gets -0.5, the best 0.5,
+			//so the step does not depend on the scale of the fitness or on outliers
+			std::vector<int> order(popSize);
+
+			for (int i = 0; i < popSize; ++i)
+			{
+				order[i] = i;
+			}
+
+			std::sort(order.begin(), order.end(), [&](int a, int b) { return scores[a] < scores[b]; });
+
+			std::vector<double> shaped(popSize);
+
+			for (int r = 0; r < popSize; ++r)
+			{
+				shaped[order[r]] = (double)r / (popSize - 1) - 0.5;
+			}
+
+			//Gradient estimate of the fitness, negated since the optimizer descends:
+			//-1 / (popSize * sigma) * sum over pairs of (shaped(+) - shaped(-)) * noise
+			int numWeights = center.size();
+			int threads = countThreads(numThreads, numPairs);
+			double scale = -1.0 / (popSize * sigma);
+
+			std::vector<std::vector<double> > partials(threads);
+			gradient.assign(numWeights, 0.0);
+
+			runThreads(threads, [&](int thread)
+			{
+				std::vector<double> noise(numWeights);
+				std::vector<double> &sum = thread == 0 ? gradient : partials[thread];
+				sum.assign(numWeights, 0.0);
+
+				for (int i = thread; i < numPairs; i += threads)
+				{
+					double factor = scale * (shaped[2 * i] - shaped[2 * i + 1]);
+
+					//Antithetic pairs of equal rank cancel out
+					if (factor == 0)
+					{
+						continue;
+					}
+
+					generateNoise(seeds[i], noise.data(), numWeights);
+
+					for (int k = 0; k < numWeights; ++k)
+					{
+						sum[k] += factor * noise[k];
+					}
+				}
+			});
+
+			for (int t = 1; t < threads; ++t)
+			{
+				for (int k = 0; k < numWeights; ++k)
+				{
+					gradient[k] += partials[t][k];
+				}
+			}
+
+			optimizer.nextStep();
+			optimizer.apply(center.data(), gradient.data(), 0, numWeights);
+
+			generation++;
+			drawSeeds();
+		}
+
+		const std::vector<double>& EvolutionStrategy::getWeights() const
+		{
+			return center;
+		}
+
+		int EvolutionStrategy::getPopulationSize() const
+		{
+			return 2 * numPairs;
+		}
+
+		int EvolutionStrategy::getGeneration() const
+		{
+			return generation;
+		}
+
+		double EvolutionStrategy::getAverageFitness() const
+		{
+			return averageFitness;
+		}
+
+		double EvolutionStrategy::getBestFitness() const
+		{
+			return bestFitness;
+		}
+
+		const std::vector<double>& EvolutionStrategy::getBestWeights() const
+		{
+			return bestWeights;
+		}
+	}
+}
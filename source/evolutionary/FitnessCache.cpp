@@ -0,0 +1,87 @@
+/**
+ * @file	evolutionary\FitnessCache.cpp.
+ *
+ * @brief	Implements the fitness cache class.
+ */
+#include "../../include/evolutionary/FitnessCache.hpp"
+#include <cstring>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		FitnessCache::FitnessCache()
+			: hits(0),
+			misses(0)
+		{
+		}
+
+		void FitnessCache::store(std::vector<Genome> &evaluated)
+		{
+			genomes.swap(evaluated);
+			index.clear();
+			index.reserve(genomes.size());
+
+			for (int i = 0; i < genomes.size(); ++i)
+			{
+				//Duplicates and colliding hashes keep the first genome
+				index.insert(std::make_pair(hashWeights(genomes[i].weights), i));
+			}
+		}
+
+		bool FitnessCache::lookup(const std::vector<double> &weights, double &fitness)
+		{
+			std::unordered_map<std::uint64_t, int>::const_iterator it = index.find(hashWeights(weights));
+
+			if (it == index.end() || genomes[it->second].weights != weights)
+			{
+				misses++;
+				return false;
+			}
+
+			fitness = genomes[it->second].fitness;
+			hits++;
+
+			return true;
+		}
+
+		void FitnessCache::clear()
+		{
+			genomes.clear();
+			index.clear();
+			hits = 0;
+			misses = 0;
+		}
+
+		long long FitnessCache::getHits() const
+		{
+			return hits;
+		}
+
+		long long FitnessCache::getMisses() const
+		{
+			return misses;
+		}
+
+		std::uint64_t FitnessCache::hashWeights(const std::vector<double> &weights)
+		{
+			std::uint64_t hash = 0x9E3779B97F4A7C15ULL ^ weights.size();
+
+			for (int i = 0; i < weights.size(); ++i)
+			{
+				std::uint64_t bits;
+				std::memcpy(&bits, &weights[i], sizeof(bits));
+
+				hash = (hash ^ bits) * 0xFF51AFD7ED558CCDULL;
+				hash ^= hash >> 32;
+			}
+
+			//Final avalanche so that the low bits used by the buckets depend on every weight
+			hash ^= hash >> 33;
+			hash *= 0xC4CEB9FE1A85EC53ULL;
+			hash ^= hash >> 33;
+
+			return hash;
+		}
+	}
+}
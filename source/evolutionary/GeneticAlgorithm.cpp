@@ -5,6 +5,10 @@
  */
 #include "../../include/evolutionary/GeneticAlgorithm.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 
 namespace etunn
 {
@@ -17,6 +21,13 @@ namespace etunn
 			chromosomeLength(numWeights),
 			totalFitness(0),
 			generation(0),
+			profiling(false),
+			allocationCounter(nullptr),
+			phaseAllocations(0),
+			caching(false),
+			adaptation(MutationAdaptation::None),
+			perturbationScale(1),
+			bestEverFitness(0),
 			fittestGenome(0),
 			bestFitness(0),
 			worstFitness(99999999),
@@ -39,17 +50,36 @@ namespace etunn
 
 		std::vector<Genome> GeneticAlgorithm::epoch(std::vector<Genome> &old_pop, Params p)
 		{
+			if (profiling)
+			{
+				currentProfile = EpochProfile();
+				currentProfile.generation = generation;
+			}
+
+			startPhase();
+
 			//Assign the given population to the classes population
 			population = old_pop;
 
+			stopPhase(EpochPhase::Copy);
+
+			//Needs the population in the order the last epoch returned it
+			measureSuccess();
+
 			//Reset everything
 			reset();
 
 			//Sort the population (for scaling and elitism)
 			std::sort(population.begin(), population.end());
 
+			stopPhase(EpochPhase::Sort);
+
 			//Calculate best, worst, average and total fitness
 			calculateBestWorstAvTot();
+			calculateDiversity();
+			adaptMutation();
+
+			stopPhase(EpochPhase::Statistics);
 
 			//Create a temporary vector to store the new chromosones
 			std::vector<Genome> newPopulation;
@@ -61,28 +91,126 @@ namespace etunn
 				grabNBest(p.numElite, p.numCopiesElite, newPopulation);
 			}
 
+			//Elites are not offspring, so they do not count for the 1/5th rule
+			parentFitness.assign(newPopulation.size(), std::numeric_limits<double>::quiet_NaN());
+
+			stopPhase(EpochPhase::Selection);
+
 			while (newPopulation.size() < popSize)
 			{
 				//Grab two chromosones
 				Genome mum = getChromoRoulette();
 				Genome dad = getChromoRoulette();
 
+				stopPhase(EpochPhase::Selection);
+
 				//Generate offspring (using crossover)
 				std::vector<double> baby1, baby2;
 				crossover(mum.weights, dad.weights, baby1, baby2);
 
+				stopPhase(EpochPhase::Crossover);
+
+				//Each baby inherits the mutation scale of the parent it starts with
+				double scale1 = mum.mutationScale, scale2 = dad.mutationScale;
+
+				if (adaptation == MutationAdaptation::SelfAdaptive)
+				{
+					//Log-normal self-adaptation with the usual learning rate 1 / sqrt(n)
+					double tau = 1 / std::sqrt((double)std::max(1, chromosomeLength));
+					scale1 *= std::exp(tau * randomGaussian());
+					scale2 *= std::exp(tau * randomGaussian());
+				}
+
 				//Mutate
-				mutate(baby1, p);
-				mutate(baby2, p);
+				mutate(baby1, perturbationScale * scale1, p);
+				mutate(baby2, perturbationScale * scale2, p);
+
+				stopPhase(EpochPhase::Mutation);
 
 				newPopulation.push_back(Genome(baby1, 0));
+				newPopulation.back().mutationScale = scale1;
 				newPopulation.push_back(Genome(baby2, 0));
+				newPopulation.back().mutationScale = scale2;
+
+				double betterParent = std::max(mum.fitness, dad.fitness);
+				parentFitness.push_back(betterParent);
+				parentFitness.push_back(betterParent);
+
+				stopPhase(EpochPhase::Copy);
+			}
+
+			//Keep the evaluated population for the fitness cache (swapped, not copied)
+			if (caching)
+			{
+				fitnessCache.store(population);
 			}
 
 			population = newPopulation;
+
+			stopPhase(EpochPhase::Copy);
+
+			if (profiling)
+			{
+				profiles.push_back(currentProfile);
+			}
+
+			++generation;
+
 			return population;
 		}
 
+		StopReason GeneticAlgorithm::run(const FitnessFunction &fitness, const StoppingCriteria &criteria, Params p)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			std::vector<Genome> pop = population;
+
+			for (int generations = 1;; ++generations)
+			{
+				//Evaluate, skipping genomes the cache knows
+				for (int i = 0; i < pop.size(); ++i)
+				{
+					if (!getCachedFitness(pop[i].weights, pop[i].fitness))
+					{
+						pop[i].fitness = fitness(pop[i].weights);
+					}
+
+					if (bestGenome.weights.empty() || pop[i].fitness > bestGenome.fitness)
+					{
+						bestGenome = pop[i];
+					}
+				}
+
+				//Also calculates the statistics the criteria look at
+				pop = epoch(pop, p);
+
+				if (bestGenome.fitness >= criteria.targetFitness)
+				{
+					return StopReason::TargetReached;
+				}
+
+				if (criteria.stagnationGenerations > 0 && stats.stagnantGenerations >= criteria.stagnationGenerations)
+				{
+					return StopReason::Stagnation;
+				}
+
+				if (stats.diversity < criteria.minDiversity)
+				{
+					return StopReason::DiversityCollapse;
+				}
+
+				if (criteria.maxSeconds > 0 &&
+					std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= criteria.maxSeconds)
+				{
+					return StopReason::TimeBudget;
+				}
+
+				if (criteria.maxGenerations > 0 && generations >= criteria.maxGenerations)
+				{
+					return StopReason::MaxGenerations;
+				}
+			}
+		}
+
 		void GeneticAlgorithm::grabNBest(int nBest, const int numCopies, std::vector<Genome> &pop)
 		{
 			while (nBest--)
@@ -124,8 +252,10 @@ namespace etunn
 			}
 		}
 
-		void GeneticAlgorithm::mutate(std::vector<double> &chromo, Params p)
+		void GeneticAlgorithm::mutate(std::vector<double> &chromo, double scale, Params p)
 		{
+			double perturbation = p.maxPerturbation * scale;
+
 			//Mutate each weight depending on the mutation rate
 			for (int i = 0; i < chromo.size(); ++i)
 			{
@@ -134,7 +264,7 @@ namespace etunn
 					//Add or subtract a small value
 					float rand1 = (rand()) / (RAND_MAX + 1.0);
 					float rand2 = (rand()) / (RAND_MAX + 1.0);
-					chromo[i] += (rand1 - rand2 * p.maxPerturbation);
+					chromo[i] += (rand1 - rand2) * perturbation;
 				}
 			}
 		}
@@ -194,6 +324,141 @@ namespace etunn
 			averageFitness = totalFitness / popSize;
 		}
 
+		void GeneticAlgorithm::measureSuccess()
+		{
+			int trials = 0, successes = 0;
+
+			if (population.size() == parentFitness.size())
+			{
+				for (int i = 0; i < population.size(); ++i)
+				{
+					if (parentFitness[i] == parentFitness[i])
+					{
+						trials++;
+
+						if (population[i].fitness > parentFitness[i])
+						{
+							successes++;
+						}
+					}
+				}
+			}
+
+			stats.successRate = trials ? (double)successes / trials : 0;
+
+			//1/5th rule: grow the steps while more than a fifth of the offspring improve, shrink them otherwise
+			if (adaptation == MutationAdaptation::OneFifthRule && trials)
+			{
+				const double factor = 0.85;
+
+				if (stats.successRate > 0.2)
+				{
+					perturbationScale = std::min(perturbationScale / factor, 1e6);
+				}
+				else if (stats.successRate < 0.2)
+				{
+					perturbationScale = std::max(perturbationScale * factor, 1e-6);
+				}
+			}
+		}
+
+		void GeneticAlgorithm::adaptMutation()
+		{
+			if (generation == 0 || bestFitness > bestEverFitness)
+			{
+				bestEverFitness = bestFitness;
+				stats.stagnantGenerations = 0;
+			}
+			else
+			{
+				stats.stagnantGenerations++;
+			}
+
+			stats.generation = generation;
+			stats.bestFitness = bestFitness;
+			stats.averageFitness = averageFitness;
+			stats.worstFitness = worstFitness;
+
+			if (schedule)
+			{
+				schedule(stats, mutationRate, perturbationScale);
+			}
+		}
+
+		double GeneticAlgorithm::randomGaussian()
+		{
+			//Box-Muller, the uniforms kept away from 0 for the logarithm
+			double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+			double u2 = (rand()) / (RAND_MAX + 1.0);
+
+			return std::sqrt(-2 * std::log(u1)) * std::cos(6.28318530717958647692 * u2);
+		}
+
+		void GeneticAlgorithm::setMutationAdaptation(MutationAdaptation adaptation)
+		{
+			this->adaptation = adaptation;
+		}
+
+		void GeneticAlgorithm::setMutationSchedule(const MutationSchedule &schedule)
+		{
+			this->schedule = schedule;
+		}
+
+		double GeneticAlgorithm::getMutationRate() const
+		{
+			return mutationRate;
+		}
+
+		double GeneticAlgorithm::getPerturbationScale() const
+		{
+			return perturbationScale;
+		}
+
+		const FitnessStats& GeneticAlgorithm::getFitnessStats() const
+		{
+			return stats;
+		}
+
+		void GeneticAlgorithm::calculateDiversity()
+		{
+			weightSums.assign(chromosomeLength, 0.0);
+			weightSquares.assign(chromosomeLength, 0.0);
+
+			int counted = 0;
+			double fitnessSquares = 0;
+
+			//One pass over the population, genome after genome
+			for (int i = 0; i < population.size(); ++i)
+			{
+				const std::vector<double> &weights = population[i].weights;
+				fitnessSquares += (population[i].fitness - averageFitness) * (population[i].fitness - averageFitness);
+
+				if (weights.size() != chromosomeLength)
+				{
+					continue;
+				}
+
+				for (int k = 0; k < chromosomeLength; ++k)
+				{
+					weightSums[k] += weights[k];
+					weightSquares[k] += weights[k] * weights[k];
+				}
+
+				counted++;
+			}
+
+			double variance = 0;
+
+			for (int k = 0; counted && k < chromosomeLength; ++k)
+			{
+				double mean = weightSums[k] / counted;
+				variance += std::max(0.0, weightSquares[k] / counted - mean * mean);
+			}
+
+			stats.diversity = chromosomeLength ? std::sqrt(variance / chromosomeLength) : 0;
+			stats.fitnessDeviation = population.empty() ? 0 : std::sqrt(fitnessSquares / population.size());
+		}
+
 		void GeneticAlgorithm::reset()
 		{
 			totalFitness = 0;
@@ -216,5 +481,79 @@ namespace etunn
 		{
 			return bestFitness;
 		}
+
+		const Genome& GeneticAlgorithm::getBestGenome() const
+		{
+			return bestGenome;
+		}
+
+		int GeneticAlgorithm::getGeneration() const
+		{
+			return generation;
+		}
+
+		void GeneticAlgorithm::enableProfiling(bool enable, long long (*allocationCounter)())
+		{
+			profiling = enable;
+			this->allocationCounter = allocationCounter;
+		}
+
+		const std::vector<EpochProfile>& GeneticAlgorithm::getProfiles() const
+		{
+			return profiles;
+		}
+
+		void GeneticAlgorithm::clearProfiles()
+		{
+			profiles.clear();
+		}
+
+		void GeneticAlgorithm::enableFitnessCache(bool enable)
+		{
+			caching = enable;
+
+			if (!caching)
+			{
+				fitnessCache.clear();
+			}
+		}
+
+		bool GeneticAlgorithm::getCachedFitness(const std::vector<double> &weights, double &fitness)
+		{
+			return caching && fitnessCache.lookup(weights, fitness);
+		}
+
+		const FitnessCache& GeneticAlgorithm::getFitnessCache() const
+		{
+			return fitnessCache;
+		}
+
+		void GeneticAlgorithm::startPhase()
+		{
+			if (!profiling)
+			{
+				return;
+			}
+
+			phaseAllocations = allocationCounter ? allocationCounter() : 0;
+			phaseStart = std::chrono::steady_clock::now();
+		}
+
+		void GeneticAlgorithm::stopPhase(EpochPhase phase)
+		{
+			if (!profiling)
+			{
+				return;
+			}
+
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			long long allocations = allocationCounter ? allocationCounter() : 0;
+
+			currentProfile.seconds[(int)phase] += std::chrono::duration<double>(now - phaseStart).count();
+			currentProfile.allocations[(int)phase] += allocations - phaseAllocations;
+
+			phaseStart = now;
+			phaseAllocations = allocations;
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,854 @@
+/**
+ * @file	evolutionary\GenomeCodec.cpp.
+ *
+ * @brief	Implements the genome codec class.
+ */
+#include "../../include/evolutionary/GenomeCodec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		namespace
+		{
+			const unsigned char magic[] = { 'E', 'T', 'G', 'C' };
+			const unsigned char formatVersion = 1;
+
+			//How a genome's weights are stored
+			const unsigned char plainGenome = 0;
+			const unsigned char deltaGenome = 1;
+
+			//Weights at each end of a genome used to look up its parents in the reference
+			const int numProbes = 4;
+
+			//Parents tried for each end of a genome
+			const int maxCandidates = 4;
+
+			//Fitness, mutation scale, the number of weights and the mode
+			const std::size_t minGenomeBytes = 8 + 8 + 1 + 1;
+
+			std::uint64_t bitsOf(double value)
+			{
+				std::uint64_t bits;
+				std::memcpy(&bits, &value, sizeof(bits));
+
+				return bits;
+			}
+
+			double doubleOf(std::uint64_t bits)
+			{
+				double value;
+				std::memcpy(&value, &bits, sizeof(value));
+
+				return value;
+			}
+
+			std::uint64_t mix(std::uint64_t hash)
+			{
+				hash ^= hash >> 30;
+				hash *= 0xBF58476D1CE4E5B9ULL;
+				hash ^= hash >> 27;
+				hash *= 0x94D049BB133111EBULL;
+
+				return hash ^ (hash >> 31);
+			}
+
+			int bytesPerWeight(WeightPrecision precision)
+			{
+				switch (precision)
+				{
+				case WeightPrecision::Double:
+					return 8;
+				case WeightPrecision::Float:
+					return 4;
+				default:
+					return 2;
+				}
+			}
+
+			//Rounds a double to a binary float with the given field widths (to the nearest, ties to even)
+			template<int exponentBits, int mantissaBits>
+			std::uint32_t packFloat(double value)
+			{
+				std::uint64_t bits = bitsOf(value);
+				std::uint32_t sign = (std::uint32_t)(bits >> 63) << (exponentBits + mantissaBits);
+				std::uint32_t maxExponent = (1u << exponentBits) - 1;
+				std::uint32_t infinity = maxExponent << mantissaBits;
+				int exponent = (int)((bits >> 52) & 0x7FF);
+				std::uint64_t mantissa = bits & ((1ULL << 52) - 1);
+
+				if (exponent == 0x7FF)
+				{
+					return sign | infinity | (mantissa ? 1u << (mantissaBits - 1) : 0);
+				}
+
+				//Double subnormals are far below the range of every target
+				if (exponent == 0)
+				{
+					return sign;
+				}
+
+				exponent += (int)(maxExponent >> 1) - 1023;
+
+				if (exponent >= (int)maxExponent)
+				{
+					return sign | infinity;
+				}
+
+				std::uint64_t base = 0;
+				int shift = 52 - mantissaBits;
+
+				if (exponent > 0)
+				{
+					base = (std::uint64_t)exponent << mantissaBits;
+				}
+				else
+				{
+					//Subnormal, shift the implicit bit in as well
+					mantissa |= 1ULL << 52;
+					shift += 1 - exponent;
+
+					if (shift > 53)
+					{
+						return sign;
+					}
+				}
+
+				std::uint64_t packed = base + (mantissa >> shift);
+				std::uint64_t rest = mantissa & ((1ULL << shift) - 1), half = 1ULL << (shift - 1);
+
+				//Branchless, as the rounding direction of weights is random. A carry out of the
+				//mantissa correctly moves on to the next exponent or to infinity
+				packed += (rest > half) | ((rest == half) & packed);
+
+				return sign | (std::uint32_t)packed;
+			}
+
+			template<int exponentBits, int mantissaBits>
+			double unpackFloat(std::uint32_t packed)
+			{
+				std::uint32_t maxExponent = (1u << exponentBits) - 1;
+				std::uint64_t exponent = (packed >> mantissaBits) & maxExponent;
+				std::uint64_t mantissa = packed & ((1u << mantissaBits) - 1);
+				std::uint64_t sign = (std::uint64_t)((packed >> (exponentBits + mantissaBits)) & 1) << 63;
+				int bias = (int)(maxExponent >> 1);
+
+				if (exponent == 0)
+				{
+					//Subnormal, scaling by a power of two is exact
+					double value = (double)mantissa * doubleOf((std::uint64_t)(1023 + 1 - bias - mantissaBits) << 52);
+					return doubleOf(bitsOf(value) | sign);
+				}
+
+				//Infinity and NaN map to the largest double exponent, everything else is rebiased
+				exponent = exponent == maxExponent ? 0x7FF : exponent + 1023 - bias;
+
+				return doubleOf(sign | exponent << 52 | mantissa << (52 - mantissaBits));
+			}
+
+			void storeFixed(unsigned char *out, std::uint64_t value, int size)
+			{
+				for (int i = 0; i < size; ++i)
+				{
+					out[i] = (unsigned char)(value >> (8 * i));
+				}
+			}
+
+			std::uint64_t loadFixed(const unsigned char *in, int size)
+			{
+				std::uint64_t value = 0;
+
+				for (int i = 0; i < size; ++i)
+				{
+					value |= (std::uint64_t)in[i] << (8 * i);
+				}
+
+				return value;
+			}
+
+			void writeFixed(std::vector<unsigned char> &bytes, std::uint64_t value, int size)
+			{
+				bytes.resize(bytes.size() + size);
+				storeFixed(&bytes[bytes.size() - size], value, size);
+			}
+
+			void writeVarint(std::vector<unsigned char> &bytes, std::uint64_t value)
+			{
+				while (value >= 0x80)
+				{
+					bytes.push_back((unsigned char)(value | 0x80));
+					value >>= 7;
+				}
+
+				bytes.push_back((unsigned char)value);
+			}
+
+			std::uint32_t floatBits(double weight)
+			{
+				float single = (float)weight;
+				std::uint32_t bits;
+				std::memcpy(&bits, &single, sizeof(bits));
+
+				return bits;
+			}
+
+			double floatOf(std::uint32_t bits)
+			{
+				float single;
+				std::memcpy(&single, &bits, sizeof(single));
+
+				return single;
+			}
+
+			//Stores weights at the given precision, with the switch outside the loops
+			void storeWeights(unsigned char *out, WeightPrecision precision, const double *weights, std::size_t count)
+			{
+				switch (precision)
+				{
+				case WeightPrecision::Double:
+					for (std::size_t i = 0; i < count; ++i, out += 8)
+					{
+						storeFixed(out, bitsOf(weights[i]), 8);
+					}
+					break;
+				case WeightPrecision::Float:
+					for (std::size_t i = 0; i < count; ++i, out += 4)
+					{
+						storeFixed(out, floatBits(weights[i]), 4);
+					}
+					break;
+				case WeightPrecision::Float16:
+					for (std::size_t i = 0; i < count; ++i, out += 2)
+					{
+						storeFixed(out, packFloat<5, 10>(weights[i]), 2);
+					}
+					break;
+				case WeightPrecision::BFloat16:
+					for (std::size_t i = 0; i < count; ++i, out += 2)
+					{
+						storeFixed(out, packFloat<8, 7>(weights[i]), 2);
+					}
+					break;
+				}
+			}
+
+			void loadWeights(const unsigned char *in, WeightPrecision precision, double *weights, std::size_t count)
+			{
+				switch (precision)
+				{
+				case WeightPrecision::Double:
+					for (std::size_t i = 0; i < count; ++i, in += 8)
+					{
+						weights[i] = doubleOf(loadFixed(in, 8));
+					}
+					break;
+				case WeightPrecision::Float:
+					for (std::size_t i = 0; i < count; ++i, in += 4)
+					{
+						weights[i] = floatOf((std::uint32_t)loadFixed(in, 4));
+					}
+					break;
+				case WeightPrecision::Float16:
+					for (std::size_t i = 0; i < count; ++i, in += 2)
+					{
+						weights[i] = unpackFloat<5, 10>((std::uint32_t)loadFixed(in, 2));
+					}
+					break;
+				case WeightPrecision::BFloat16:
+					for (std::size_t i = 0; i < count; ++i, in += 2)
+					{
+						weights[i] = unpackFloat<8, 7>((std::uint32_t)loadFixed(in, 2));
+					}
+					break;
+				}
+			}
+
+			void appendWeights(std::vector<unsigned char> &bytes, WeightPrecision precision, const double *weights, std::size_t count)
+			{
+				std::size_t offset = bytes.size();
+				bytes.resize(offset + count * bytesPerWeight(precision));
+				storeWeights(bytes.data() + offset, precision, weights, count);
+			}
+
+			/**
+			 * @struct	Reader
+			 *
+			 * @brief	Reads from encoded bytes. Reading past the end yields zeros and clears ok.
+			 */
+			struct Reader
+			{
+				const unsigned char *position, *end;
+				bool ok;
+
+				Reader(const std::vector<unsigned char> &bytes)
+					: position(bytes.data()), end(bytes.data() + bytes.size()), ok(true) {}
+
+				std::size_t remaining() const
+				{
+					return end - position;
+				}
+
+				//Checks that size bytes are left
+				bool take(std::size_t size)
+				{
+					if (remaining() < size)
+					{
+						ok = false;
+						position = end;
+					}
+
+					return ok;
+				}
+
+				std::uint64_t fixed(int size)
+				{
+					if (!take(size))
+					{
+						return 0;
+					}
+
+					std::uint64_t value = loadFixed(position, size);
+					position += size;
+
+					return value;
+				}
+
+				std::uint64_t varint()
+				{
+					std::uint64_t value = 0;
+
+					for (int shift = 0; shift < 64; shift += 7)
+					{
+						if (position == end)
+						{
+							break;
+						}
+
+						unsigned char byte = *position++;
+						value |= (std::uint64_t)(byte & 0x7F) << shift;
+
+						if (!(byte & 0x80))
+						{
+							return value;
+						}
+					}
+
+					ok = false;
+					position = end;
+
+					return 0;
+				}
+
+				void weights(WeightPrecision precision, double *weights, std::size_t count)
+				{
+					if (take(count * bytesPerWeight(precision)))
+					{
+						loadWeights(position, precision, weights, count);
+						position += count * bytesPerWeight(precision);
+					}
+				}
+			};
+
+			std::uint64_t probeKey(int slot, std::size_t size, double weight)
+			{
+				return mix(bitsOf(weight) ^ mix(size * numProbes * 2 + slot));
+			}
+
+			/**
+			 * @class	ParentIndex
+			 *
+			 * @brief	Finds the reference genomes that a genome may have been bred from, by looking up
+			 * 			the weights at both of its ends. The ends survive single-point crossover and are
+			 * 			only lost if every probed weight was mutated.
+			 */
+			class ParentIndex
+			{
+			public:
+				ParentIndex(const std::vector<Genome> &reference)
+				{
+					genomes.reserve(reference.size() * numProbes * 2);
+
+					for (int r = 0; r < reference.size(); ++r)
+					{
+						const std::vector<double> &weights = reference[r].weights;
+
+						if (weights.empty() || isCopy(reference, weights))
+						{
+							continue;
+						}
+
+						int probes = std::min(numProbes, (int)weights.size());
+
+						for (int k = 0; k < probes; ++k)
+						{
+							insert(probeKey(k, weights.size(), weights[k]), r);
+							insert(probeKey(numProbes + k, weights.size(), weights[weights.size() - 1 - k]), r);
+						}
+					}
+				}
+
+				//Fills the candidates for the start and the end of a set of weights
+				void find(const std::vector<double> &weights, std::vector<int> &heads, std::vector<int> &tails) const
+				{
+					heads.clear();
+					tails.clear();
+
+					int probes = std::min(numProbes, (int)weights.size());
+
+					for (int k = 0; k < probes; ++k)
+					{
+						collect(probeKey(k, weights.size(), weights[k]), heads);
+						collect(probeKey(numProbes + k, weights.size(), weights[weights.size() - 1 - k]), tails);
+					}
+				}
+
+			private:
+				std::unordered_map<std::uint64_t, std::vector<int> > genomes;
+
+				//Copies of a genome (e.g. elites) are indexed once, so they do not crowd out other candidates.
+				//A copy shares the first weight with the original, so only genomes found by that are compared
+				bool isCopy(const std::vector<Genome> &reference, const std::vector<double> &weights) const
+				{
+					std::unordered_map<std::uint64_t, std::vector<int> >::const_iterator it = genomes.find(probeKey(0, weights.size(), weights[0]));
+
+					if (it != genomes.end())
+					{
+						for (int i = 0; i < it->second.size(); ++i)
+						{
+							if (reference[it->second[i]].weights == weights)
+							{
+								return true;
+							}
+						}
+					}
+
+					return false;
+				}
+
+				void insert(std::uint64_t key, int genome)
+				{
+					std::vector<int> &entry = genomes[key];
+
+					if (entry.size() < maxCandidates)
+					{
+						entry.push_back(genome);
+					}
+				}
+
+				void collect(std::uint64_t key, std::vector<int> &candidates) const
+				{
+					std::unordered_map<std::uint64_t, std::vector<int> >::const_iterator it = genomes.find(key);
+
+					if (it == genomes.end())
+					{
+						return;
+					}
+
+					for (int i = 0; i < it->second.size() && candidates.size() < maxCandidates; ++i)
+					{
+						if (std::find(candidates.begin(), candidates.end(), it->second[i]) == candidates.end())
+						{
+							candidates.push_back(it->second[i]);
+						}
+					}
+				}
+			};
+
+			bool differs(double a, double b)
+			{
+				return bitsOf(a) != bitsOf(b);
+			}
+
+			/**
+			 * @struct	Splice
+			 *
+			 * @brief	A genome described as the start of one reference genome and the end of another.
+			 */
+			struct Splice
+			{
+				int head, tail, split, changes;
+
+				/** @brief	Where the genome differs from head and from tail, ascending. */
+				std::vector<int> headChanges, tailChanges;
+
+				Splice() : head(-1), tail(-1), split(0), changes(std::numeric_limits<int>::max()) {}
+
+				/**
+				 * @fn	void splice(const std::vector<double> &weights, const std::vector<Genome> &reference, int h, int t)
+				 *
+				 * @brief	Finds the split of reference genomes h and t leaving the fewest weights differing,
+				 * 			in a single pass: splitting at i leaves headChanges(i) + tailChanges - tailChanges(i).
+				 */
+				void splice(const std::vector<double> &weights, const std::vector<Genome> &reference, int h, int t)
+				{
+					const std::vector<double> &headWeights = reference[h].weights;
+					const std::vector<double> &tailWeights = reference[t].weights;
+					int best = 0;
+
+					head = h;
+					tail = t;
+					split = 0;
+					headChanges.clear();
+					tailChanges.clear();
+
+					for (int i = 0; i < weights.size(); ++i)
+					{
+						if (differs(weights[i], headWeights[i]))
+						{
+							headChanges.push_back(i);
+						}
+
+						if (differs(weights[i], tailWeights[i]))
+						{
+							tailChanges.push_back(i);
+						}
+
+						if ((int)headChanges.size() - (int)tailChanges.size() < best)
+						{
+							best = (int)headChanges.size() - (int)tailChanges.size();
+							split = i + 1;
+						}
+					}
+
+					changes = best + tailChanges.size();
+				}
+			};
+		}
+
+		GenomeCodec::GenomeCodec(WeightPrecision precision)
+			: precision(precision)
+		{
+		}
+
+		void GenomeCodec::encode(const std::vector<Genome> &population, std::vector<unsigned char> &bytes) const
+		{
+			std::size_t size = 0;
+
+			for (int g = 0; g < population.size(); ++g)
+			{
+				size += minGenomeBytes + population[g].weights.size() * bytesPerWeight(precision);
+			}
+
+			bytes.clear();
+			bytes.reserve(size + 64);
+			writeHeader(bytes, population.size(), nullptr);
+
+			for (int g = 0; g < population.size(); ++g)
+			{
+				writeWeights(bytes, population[g]);
+			}
+		}
+
+		void GenomeCodec::encode(const std::vector<Genome> &population, const std::vector<Genome> &reference,
+			std::vector<unsigned char> &bytes) const
+		{
+			bytes.clear();
+			writeHeader(bytes, population.size(), &reference);
+
+			ParentIndex parents(reference);
+			std::vector<int> heads, tails;
+			std::vector<unsigned char> delta;
+			Splice best, candidate;
+
+			for (int g = 0; g < population.size(); ++g)
+			{
+				const std::vector<double> &weights = population[g].weights;
+				parents.find(weights, heads, tails);
+
+				//Without a crossover both ends come from the same parent
+				if (heads.empty())
+				{
+					heads = tails;
+				}
+				else if (tails.empty())
+				{
+					tails = heads;
+				}
+
+				best.head = -1;
+				best.changes = std::numeric_limits<int>::max();
+
+				//An exact match (e.g. an elite) cannot be beaten
+				for (int h = 0; h < heads.size() && best.changes > 0; ++h)
+				{
+					for (int t = 0; t < tails.size() && best.changes > 0; ++t)
+					{
+						candidate.splice(weights, reference, heads[h], tails[t]);
+
+						if (candidate.changes < best.changes)
+						{
+							std::swap(best, candidate);
+						}
+					}
+				}
+
+				delta.clear();
+
+				if (best.head >= 0)
+				{
+					writeVarint(delta, best.head);
+					writeVarint(delta, best.tail);
+					writeVarint(delta, best.split);
+					writeVarint(delta, best.changes);
+
+					int previous = -1;
+
+					//The changes before the split are relative to head, the others to tail
+					for (int i = 0; i < best.headChanges.size() && best.headChanges[i] < best.split; ++i)
+					{
+						writeVarint(delta, best.headChanges[i] - previous - 1);
+						appendWeights(delta, precision, &weights[best.headChanges[i]], 1);
+						previous = best.headChanges[i];
+					}
+
+					std::vector<int>::const_iterator it = std::lower_bound(best.tailChanges.begin(), best.tailChanges.end(), best.split);
+
+					for (; it != best.tailChanges.end(); ++it)
+					{
+						writeVarint(delta, *it - previous - 1);
+						appendWeights(delta, precision, &weights[*it], 1);
+						previous = *it;
+					}
+				}
+
+				//Fall back to storing every weight if that is not larger
+				if (best.head < 0 || delta.size() >= weights.size() * bytesPerWeight(precision))
+				{
+					writeWeights(bytes, population[g]);
+					continue;
+				}
+
+				writeFixed(bytes, bitsOf(population[g].fitness), 8);
+				writeFixed(bytes, bitsOf(population[g].mutationScale), 8);
+				writeVarint(bytes, weights.size());
+				bytes.push_back(deltaGenome);
+				bytes.insert(bytes.end(), delta.begin(), delta.end());
+			}
+		}
+
+		bool GenomeCodec::decode(const std::vector<unsigned char> &bytes, std::vector<Genome> &population)
+		{
+			return decode(bytes, std::vector<Genome>(), population);
+		}
+
+		bool GenomeCodec::decode(const std::vector<unsigned char> &bytes, const std::vector<Genome> &reference,
+			std::vector<Genome> &population)
+		{
+			//The genomes already in the population keep their memory
+			Reader reader(bytes);
+
+			if (reader.remaining() < sizeof(magic) + 3 || std::memcmp(bytes.data(), magic, sizeof(magic)) != 0)
+			{
+				population.clear();
+				return false;
+			}
+
+			reader.position += sizeof(magic);
+
+			unsigned char version = (unsigned char)reader.fixed(1);
+			unsigned char precisionByte = (unsigned char)reader.fixed(1);
+			bool hasReference = reader.fixed(1) != 0;
+
+			if (version != formatVersion || precisionByte > (unsigned char)WeightPrecision::BFloat16)
+			{
+				population.clear();
+				return false;
+			}
+
+			WeightPrecision precision = (WeightPrecision)precisionByte;
+			std::uint64_t numGenomes = reader.varint();
+
+			if (hasReference && (reader.varint() != reference.size() || reader.fixed(8) != checksum(reference)))
+			{
+				population.clear();
+				return false;
+			}
+
+			//Every genome takes a few bytes, so a corrupt count cannot trigger a huge allocation
+			if (!reader.ok || numGenomes > reader.remaining() / minGenomeBytes)
+			{
+				population.clear();
+				return false;
+			}
+
+			population.resize(numGenomes);
+
+			for (int g = 0; g < population.size() && reader.ok; ++g)
+			{
+				Genome &genome = population[g];
+				genome.fitness = doubleOf(reader.fixed(8));
+				genome.mutationScale = doubleOf(reader.fixed(8));
+
+				std::uint64_t numWeights = reader.varint();
+				unsigned char mode = (unsigned char)reader.fixed(1);
+
+				if (mode == plainGenome)
+				{
+					if (numWeights > reader.remaining() / bytesPerWeight(precision))
+					{
+						reader.ok = false;
+						break;
+					}
+
+					genome.weights.resize(numWeights);
+					reader.weights(precision, genome.weights.data(), numWeights);
+
+					continue;
+				}
+
+				std::uint64_t head = reader.varint(), tail = reader.varint();
+				std::uint64_t split = reader.varint(), changes = reader.varint();
+
+				if (mode != deltaGenome || !hasReference || head >= reference.size() || tail >= reference.size()
+					|| reference[head].weights.size() != numWeights || reference[tail].weights.size() != numWeights
+					|| split > numWeights || changes > numWeights)
+				{
+					reader.ok = false;
+					break;
+				}
+
+				genome.weights.resize(numWeights);
+				std::copy(reference[head].weights.begin(), reference[head].weights.begin() + split, genome.weights.begin());
+				std::copy(reference[tail].weights.begin() + split, reference[tail].weights.end(), genome.weights.begin() + split);
+
+				std::uint64_t index = 0;
+
+				for (std::uint64_t c = 0; c < changes && reader.ok; ++c)
+				{
+					std::uint64_t gap = reader.varint();
+
+					if (gap >= numWeights - index)
+					{
+						reader.ok = false;
+						break;
+					}
+
+					index += gap;
+					reader.weights(precision, &genome.weights[index++], 1);
+				}
+			}
+
+			//Trailing bytes mean the data was not produced by encode()
+			if (!reader.ok || reader.remaining() != 0)
+			{
+				population.clear();
+				return false;
+			}
+
+			return true;
+		}
+
+		bool GenomeCodec::save(const std::string &path, const std::vector<unsigned char> &bytes)
+		{
+			std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+
+			if (!file)
+			{
+				return false;
+			}
+
+			file.write((const char*)bytes.data(), bytes.size());
+
+			return (bool)file;
+		}
+
+		bool GenomeCodec::load(const std::string &path, std::vector<unsigned char> &bytes)
+		{
+			bytes.clear();
+
+			std::ifstream file(path.c_str(), std::ios::binary);
+
+			if (!file)
+			{
+				return false;
+			}
+
+			bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+			return !file.bad();
+		}
+
+		double GenomeCodec::round(WeightPrecision precision, double weight)
+		{
+			switch (precision)
+			{
+			case WeightPrecision::Float:
+				return (float)weight;
+			case WeightPrecision::Float16:
+				return unpackFloat<5, 10>(packFloat<5, 10>(weight));
+			case WeightPrecision::BFloat16:
+				return unpackFloat<8, 7>(packFloat<8, 7>(weight));
+			default:
+				return weight;
+			}
+		}
+
+		WeightPrecision GenomeCodec::getPrecision() const
+		{
+			return precision;
+		}
+
+		void GenomeCodec::writeHeader(std::vector<unsigned char> &bytes, int numGenomes, const std::vector<Genome> *reference) const
+		{
+			bytes.insert(bytes.end(), magic, magic + sizeof(magic));
+			bytes.push_back(formatVersion);
+			bytes.push_back((unsigned char)precision);
+			bytes.push_back(reference != nullptr);
+			writeVarint(bytes, numGenomes);
+
+			if (reference != nullptr)
+			{
+				writeVarint(bytes, reference->size());
+				writeFixed(bytes, checksum(*reference), 8);
+			}
+		}
+
+		void GenomeCodec::writeWeights(std::vector<unsigned char> &bytes, const Genome &genome) const
+		{
+			writeFixed(bytes, bitsOf(genome.fitness), 8);
+			writeFixed(bytes, bitsOf(genome.mutationScale), 8);
+			writeVarint(bytes, genome.weights.size());
+			bytes.push_back(plainGenome);
+			appendWeights(bytes, precision, genome.weights.data(), genome.weights.size());
+		}
+
+		std::uint64_t GenomeCodec::checksum(const std::vector<Genome> &population)
+		{
+			std::uint64_t hash = mix(population.size());
+
+			for (int g = 0; g < population.size(); ++g)
+			{
+				const std::vector<double> &weights = population[g].weights;
+
+				//Four independent chains, so the multiplications overlap
+				std::uint64_t lanes[4] = { hash ^ weights.size(), hash + 1, hash + 2, hash + 3 };
+				int i = 0;
+
+				for (; i + 4 <= weights.size(); i += 4)
+				{
+					for (int l = 0; l < 4; ++l)
+					{
+						lanes[l] = (lanes[l] ^ bitsOf(weights[i + l])) * 0xFF51AFD7ED558CCDULL;
+						lanes[l] ^= lanes[l] >> 32;
+					}
+				}
+
+				for (; i < weights.size(); ++i)
+				{
+					lanes[0] = mix(lanes[0] ^ bitsOf(weights[i]));
+				}
+
+				hash = mix(mix(mix(lanes[0] ^ lanes[1]) ^ lanes[2]) ^ lanes[3]);
+			}
+
+			return hash;
+		}
+	}
+}
@@ -0,0 +1,201 @@
+/**
+ * @file	evolutionary\IncrementalEvaluator.cpp.
+ *
+ * @brief	Implements the incremental evaluator class.
+ */
+#include "../../include/evolutionary/IncrementalEvaluator.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		IncrementalEvaluator::IncrementalEvaluator(const Topology &topology, const std::vector<std::vector<double> > &inputs, Params p)
+			: topology(topology),
+			inputs(inputs),
+			bias(p.bias),
+			response(p.activationResponse),
+			recomputed(0)
+		{
+			int numLayers = topology.layerSizes.size();
+			int offset = 0;
+
+			//The forward passes read numInputs values of every sample
+			for (int s = 0; s < this->inputs.size(); ++s)
+			{
+				if (this->inputs[s].size() != topology.numInputs)
+				{
+					this->inputs[s].assign(topology.numInputs, 0);
+				}
+			}
+
+			for (int i = 0; i < numLayers; ++i)
+			{
+				layerOffsets.push_back(offset);
+				offset += topology.layerSizes[i] * (topology.getLayerInputs(i) + 1);
+
+				changedWeights.push_back(std::vector<std::vector<int> >(topology.layerSizes[i]));
+				dirtyNeurons.push_back(std::vector<int>());
+				childActivations.push_back(std::vector<double>(topology.layerSizes[i]));
+			}
+		}
+
+		void IncrementalEvaluator::setParent(const std::vector<double> &weights)
+		{
+			int numLayers = topology.layerSizes.size();
+
+			parentWeights = weights;
+			parentSums.assign(inputs.size(), std::vector<std::vector<double> >(numLayers));
+			parentActivations.assign(inputs.size(), std::vector<std::vector<double> >(numLayers));
+			parentOutputs.assign(inputs.size(), std::vector<double>());
+
+			if (weights.size() != topology.getNumberOfWeights())
+			{
+				parentWeights.clear();
+				return;
+			}
+
+			for (int s = 0; s < inputs.size(); ++s)
+			{
+				for (int l = 0; l < numLayers; ++l)
+				{
+					int numInputs = topology.getLayerInputs(l);
+					const std::vector<double> &in = l == 0 ? inputs[s] : parentActivations[s][l - 1];
+
+					parentSums[s][l].resize(topology.layerSizes[l]);
+					parentActivations[s][l].resize(topology.layerSizes[l]);
+
+					for (int j = 0; j < topology.layerSizes[l]; ++j)
+					{
+						const double *row = &weights[layerOffsets[l] + j * (numInputs + 1)];
+						double netinput = 0;
+
+						for (int k = 0; k < numInputs; ++k)
+						{
+							netinput += row[k] * in[k];
+						}
+
+						netinput += row[numInputs] * bias;
+
+						parentSums[s][l][j] = netinput;
+						parentActivations[s][l][j] = activate(topology.activations[l], netinput, response, topology.accuracy);
+					}
+				}
+
+				parentOutputs[s] = parentActivations[s][numLayers - 1];
+			}
+		}
+
+		const std::vector<std::vector<double> >& IncrementalEvaluator::getParentOutputs() const
+		{
+			return parentOutputs;
+		}
+
+		void IncrementalEvaluator::evaluate(const std::vector<double> &weights, std::vector<std::vector<double> > &outputs)
+		{
+			int numLayers = topology.layerSizes.size();
+
+			recomputed = 0;
+
+			if (parentWeights.empty() || weights.size() != parentWeights.size())
+			{
+				outputs.clear();
+				return;
+			}
+
+			outputs = parentOutputs;
+
+			//Find the changed weights and the neurons they belong to
+			for (int l = 0; l < numLayers; ++l)
+			{
+				int numInputs = topology.getLayerInputs(l);
+
+				dirtyNeurons[l].clear();
+
+				for (int j = 0; j < topology.layerSizes[l]; ++j)
+				{
+					int row = layerOffsets[l] + j * (numInputs + 1);
+					std::vector<int> &changed = changedWeights[l][j];
+
+					changed.clear();
+
+					for (int k = 0; k <= numInputs; ++k)
+					{
+						if (weights[row + k] != parentWeights[row + k])
+						{
+							changed.push_back(k);
+						}
+					}
+
+					if (!changed.empty())
+					{
+						dirtyNeurons[l].push_back(j);
+					}
+				}
+			}
+
+			//Propagate the changes for each input
+			for (int s = 0; s < inputs.size(); ++s)
+			{
+				changedInputs.clear();
+
+				for (int l = 0; l < numLayers; ++l)
+				{
+					int numInputs = topology.getLayerInputs(l);
+					const std::vector<double> &in = l == 0 ? inputs[s] : parentActivations[s][l - 1];
+
+					//A changed input reaches every neuron of a dense layer, otherwise only the neurons with changed weights change
+					bool allNeurons = !changedInputs.empty();
+					int numNeurons = allNeurons ? topology.layerSizes[l] : dirtyNeurons[l].size();
+
+					changedOutputs.clear();
+
+					for (int d = 0; d < numNeurons; ++d)
+					{
+						int j = allNeurons ? d : dirtyNeurons[l][d];
+						int row = layerOffsets[l] + j * (numInputs + 1);
+						double netinput = parentSums[s][l][j];
+
+						//Changed weights times the inputs of the parent
+						for (int c = 0; c < changedWeights[l][j].size(); ++c)
+						{
+							int k = changedWeights[l][j][c];
+							double input = k == numInputs ? bias : in[k];
+
+							netinput += (weights[row + k] - parentWeights[row + k]) * input;
+						}
+
+						//New weights times the change of the inputs
+						for (int c = 0; c < changedInputs.size(); ++c)
+						{
+							int k = changedInputs[c];
+
+							netinput += weights[row + k] * (childActivations[l - 1][k] - in[k]);
+						}
+
+						double activation = activate(topology.activations[l], netinput, response, topology.accuracy);
+
+						//Neurons that end up where they were (e.g. saturated or inactive) stop the propagation
+						if (activation != parentActivations[s][l][j])
+						{
+							childActivations[l][j] = activation;
+							changedOutputs.push_back(j);
+						}
+					}
+
+					recomputed += numNeurons;
+					changedInputs.swap(changedOutputs);
+				}
+
+				for (int c = 0; c < changedInputs.size(); ++c)
+				{
+					outputs[s][changedInputs[c]] = childActivations[numLayers - 1][changedInputs[c]];
+				}
+			}
+		}
+
+		int IncrementalEvaluator::getNumberOfRecomputedNeurons() const
+		{
+			return recomputed;
+		}
+	}
+}
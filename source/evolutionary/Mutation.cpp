@@ -0,0 +1,36 @@
+/**
+ * @file	evolutionary\Mutation.cpp.
+ *
+ * @brief	Implements the mutation schedules of the genetic algorithm.
+ */
+#include "../../include/evolutionary/Mutation.hpp"
+#include <algorithm>
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		MutationSchedule decaySchedule(double factor, double minScale)
+		{
+			return [factor, minScale](const FitnessStats &, double &, double &perturbationScale)
+			{
+				perturbationScale = std::max(minScale, perturbationScale * factor);
+			};
+		}
+
+		MutationSchedule stagnationSchedule(int patience, double factor, double maxScale)
+		{
+			return [patience, factor, maxScale](const FitnessStats &stats, double &, double &perturbationScale)
+			{
+				if (stats.stagnantGenerations == 0)
+				{
+					perturbationScale = 1;
+				}
+				else if (patience > 0 && stats.stagnantGenerations % patience == 0)
+				{
+					perturbationScale = std::min(maxScale, perturbationScale * factor);
+				}
+			};
+		}
+	}
+}
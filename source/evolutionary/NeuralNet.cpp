@@ -4,6 +4,8 @@
  * @brief	Implements the evolutionary neural net class.
  */
 #include "../../include/evolutionary/NeuralNet.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace etunn
 {
@@ -19,31 +21,32 @@ namespace etunn
 			numInputs = p.numInputs;
 			numOutputs = p.numOutputs;
 			numHiddenLayers = p.numHidden;
-			neuronsPerHiddenLyr = p.neuronsPerHiddenLayer;
+			hiddenLayerSizes = p.hiddenLayerSizes;
+			layerActivations = p.layerActivations;
+			accuracy = p.mathAccuracy;
+
+			//Fall back to equally sized sigmoid layers if the sizes were not set via setParams
+			hiddenLayerSizes.resize(numHiddenLayers, p.neuronsPerHiddenLayer);
+			layerActivations.resize(numHiddenLayers + 1, Activation::Sigmoid);
 		}
 
 		void NeuralNet::createNet()
 		{
-			//Create the layers of the network
-			if (numHiddenLayers > 0)
-			{
-				//Create first hidden layer
-				layers.push_back(NeuronLayer(neuronsPerHiddenLyr, numInputs));
-
-				//Create the other layers
-				for (int i = 0; i < numHiddenLayers - 1; ++i)
-				{
-					layers.push_back(NeuronLayer(neuronsPerHiddenLyr, neuronsPerHiddenLyr));
-				}
+			int inputs = numInputs;
 
-				//Create output layer
-				layers.push_back(NeuronLayer(numOutputs, neuronsPerHiddenLyr));
-			}
-			else
+			//Create the hidden layers, each one fed by the previous one
+			for (int i = 0; i < numHiddenLayers; ++i)
 			{
-				//Create output layer
-				layers.push_back(NeuronLayer(numOutputs, numInputs));
+				layers.push_back(NeuronLayer(hiddenLayerSizes[i], inputs, layerActivations[i], accuracy));
+				inputs = hiddenLayerSizes[i];
 			}
+
+			//Create output layer
+			layers.push_back(NeuronLayer(numOutputs, inputs, layerActivations[numHiddenLayers], accuracy));
+
+#ifdef ETUNN_INSTRUMENTATION
+			inferenceStats = InferenceStats(numHiddenLayers + 1);
+#endif
 		}
 
 		std::vector<double> NeuralNet::getWeights() const
@@ -58,10 +61,8 @@ namespace etunn
 				for (int j = 0; j < layers[i].numNeurons; ++j)
 				{
 					//Weights
-					for (int k = 0; k < layers[i].neurons[j].numInputs; ++k)
-					{
-						weights.push_back(layers[i].neurons[j].weights[k]);
-					}
+					std::vector<double> neuronWeights = layers[i].getNeuronWeights(j);
+					weights.insert(weights.end(), neuronWeights.begin(), neuronWeights.end());
 				}
 			}
 
@@ -75,6 +76,9 @@ namespace etunn
 			//Layers
 			for (int i = 0; i < numHiddenLayers + 1; ++i)
 			{
+				//The new weights may contain any amount of zeros
+				layers[i].decompress();
+
 				//Neurons
 				for (int j = 0; j < layers[i].numNeurons; ++j)
 				{
@@ -87,6 +91,18 @@ namespace etunn
 			}
 		}
 
+		Topology NeuralNet::getTopology() const
+		{
+			Topology topology;
+			topology.numInputs = numInputs;
+			topology.layerSizes = hiddenLayerSizes;
+			topology.layerSizes.push_back(numOutputs);
+			topology.activations = layerActivations;
+			topology.accuracy = accuracy;
+
+			return topology;
+		}
+
 		int NeuralNet::getNumberOfWeights() const
 		{
 			int weights = 0;
@@ -94,79 +110,157 @@ namespace etunn
 			//Layers
 			for (int i = 0; i < numHiddenLayers + 1; ++i)
 			{
-				//Neurons
-				for (int j = 0; j < layers[i].numNeurons; ++j)
-				{
-					//Weights
-					for (int k = 0; k < layers[i].neurons[j].numInputs; ++k)
-						weights++;
-				}
+				weights += layers[i].numNeurons * (layers[i].numInputsPerNeuron + 1);
 			}
 
 			return weights;
 		}
 
-		std::vector<double> NeuralNet::update(std::vector<double> &inputs, Params p)
+		int NeuralNet::prune(double threshold)
 		{
-			//Stores the resultant outputs from each layer
-			std::vector<double> outputs;
+			int pruned = 0;
 
-			int weight = 0;
-
-			//Check that the amount of inputs is correct
-			if (inputs.size() != numInputs)
+			for (int i = 0; i < numHiddenLayers + 1; ++i)
 			{
-				//Return an empty vector if incorrect.
-				return outputs;
+				NeuronLayer &layer = layers[i];
+
+				if (layer.sparse)
+				{
+					//Drop the small entries from the compressed rows
+					int kept = 0;
+
+					for (int j = 0; j < layer.numNeurons; ++j)
+					{
+						int start = layer.rowStart[j];
+						layer.rowStart[j] = kept;
+
+						for (int e = start; e < layer.rowStart[j + 1]; ++e)
+						{
+							if (std::fabs(layer.values[e]) < threshold)
+							{
+								pruned++;
+								continue;
+							}
+
+							layer.columns[kept] = layer.columns[e];
+							layer.values[kept] = layer.values[e];
+							kept++;
+						}
+
+						if (std::fabs(layer.biasWeights[j]) < threshold && layer.biasWeights[j] != 0)
+						{
+							layer.biasWeights[j] = 0;
+							pruned++;
+						}
+					}
+
+					layer.rowStart[layer.numNeurons] = kept;
+					layer.columns.resize(kept);
+					layer.values.resize(kept);
+					continue;
+				}
+
+				for (int j = 0; j < layer.numNeurons; ++j)
+				{
+					for (int k = 0; k < layer.neurons[j].numInputs; ++k)
+					{
+						if (std::fabs(layer.neurons[j].weights[k]) < threshold && layer.neurons[j].weights[k] != 0)
+						{
+							layer.neurons[j].weights[k] = 0;
+							pruned++;
+						}
+					}
+				}
 			}
 
-			//Layers
+			return pruned;
+		}
+
+		void NeuralNet::sparsify(double maxDensity)
+		{
 			for (int i = 0; i < numHiddenLayers + 1; ++i)
 			{
-				if (i > 0)
+				if (layers[i].getDensity() < maxDensity)
 				{
-					inputs = outputs;
+					layers[i].compress();
 				}
+				else
+				{
+					layers[i].decompress();
+				}
+			}
+		}
 
-				outputs.clear();
-
-				weight = 0;
+		int NeuralNet::getNumberOfNonZeroWeights() const
+		{
+			int weights = 0;
 
-				//Sum the (inputs * corresponding weights) for each neuron
-				//Run the total at through sigmoid function to get the output
+			for (int i = 0; i < numHiddenLayers + 1; ++i)
+			{
 				for (int j = 0; j < layers[i].numNeurons; ++j)
 				{
-					double netinput = 0;
-
-					int	NumInputs = layers[i].neurons[j].numInputs;
+					std::vector<double> neuronWeights = layers[i].getNeuronWeights(j);
 
-					//Weights
-					for (int k = 0; k < layers[i].neurons[j].weights.size() - 1; ++k)
+					for (int k = 0; k < neuronWeights.size(); ++k)
 					{
-						//Sum the weights * inputs
-						netinput += layers[i].neurons[j].weights[k] *
-							inputs[weight++];
+						if (neuronWeights[k] != 0)
+							weights++;
 					}
+				}
+			}
 
-					//Add in the bias
-					netinput += layers[i].neurons[j].weights[NumInputs - 1] *
-						p.bias;
-
-					//Store the outputs from each layer as they get generated
-					//The combined activation is first filtered through the sigmoid  function
-					outputs.push_back(sigmoid(netinput,
-						p.activationResponse));
+			return weights;
+		}
 
-					weight = 0;
-				}
+		std::vector<double> NeuralNet::update(const std::vector<double> &inputs, Params p) const
+		{
+			//Check that the amount of inputs is correct
+			if (inputs.size() != numInputs)
+			{
+				//Return an empty vector if incorrect.
+				return std::vector<double>();
 			}
 
+			return update(inputs.data(), p);
+		}
+
+		std::vector<double> NeuralNet::update(const double *inputs, Params p) const
+		{
+			//Every thread reuses its own scratch space
+			static thread_local Workspace workspace;
+
+			std::vector<double> outputs(numOutputs);
+			update(inputs, outputs.data(), workspace, p);
+
 			return outputs;
 		}
 
-		inline double NeuralNet::sigmoid(double activation, double response)
+		Workspace NeuralNet::createWorkspace() const
+		{
+			int largestLayer = 0;
+
+			for (int i = 0; i < numHiddenLayers; ++i)
+			{
+				largestLayer = std::max(largestLayer, hiddenLayerSizes[i]);
+			}
+
+			Workspace workspace;
+			workspace.layerA.reserve(largestLayer);
+			workspace.layerB.reserve(largestLayer);
+
+			return workspace;
+		}
+
+#ifdef ETUNN_INSTRUMENTATION
+		const InferenceStats& NeuralNet::getInferenceStats() const
+		{
+			return inferenceStats;
+		}
+
+		void NeuralNet::resetInferenceStats()
 		{
-			return (1 / (1 + exp(-activation / response)));
+			inferenceStats.reset();
 		}
+#endif
 	}
 }
\ No newline at end of file
@@ -0,0 +1,355 @@
+/**
+ * @file	evolutionary\PopulationEvaluator.cpp.
+ *
+ * @brief	Implements the population evaluator class.
+ */
+#include <algorithm>
+
+#include "../../include/Activation.hpp"
+#include "../../include/evolutionary/PopulationEvaluator.hpp"
+#include "../../include/Simd.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		namespace
+		{
+			using namespace simd;
+
+			/** @brief	Samples evaluated together, four packs so the sums form independent chains. */
+			const int blockSize = 4 * packSize;
+
+			/** @brief	Genomes interleaved together, for the same reason. */
+			const int groupSize = 4 * packSize;
+
+			/**
+			 * @brief	Calculates the net inputs of one layer for a block of samples. Each weight is
+			 * 			broadcast once and applied to the whole block. Kept apart from the activation,
+			 * 			whose calls would otherwise force the sums out of the vector registers.
+			 */
+			void blockSums(const double *weights, int numInputs, int numNeurons, const double *inputs, double *outputs, double bias)
+			{
+				for (int j = 0; j < numNeurons; ++j)
+				{
+					const double *row = weights + j * (numInputs + 1);
+					Pack sum0 = broadcast(row[numInputs] * bias);
+					Pack sum1 = sum0, sum2 = sum0, sum3 = sum0;
+
+					for (int k = 0; k < numInputs; ++k)
+					{
+						Pack weight = broadcast(row[k]);
+						const double *in = inputs + k * blockSize;
+
+						sum0 = add(sum0, mul(weight, load(in)));
+						sum1 = add(sum1, mul(weight, load(in + packSize)));
+						sum2 = add(sum2, mul(weight, load(in + 2 * packSize)));
+						sum3 = add(sum3, mul(weight, load(in + 3 * packSize)));
+					}
+
+					double *out = outputs + j * blockSize;
+
+					store(out, sum0);
+					store(out + packSize, sum1);
+					store(out + 2 * packSize, sum2);
+					store(out + 3 * packSize, sum3);
+				}
+			}
+
+			/**
+			 * @brief	Calculates the net inputs of one layer for one sample and a group of interleaved
+			 * 			genomes. Every weight and input is a pack of the lanes of the group, so one
+			 * 			instruction advances several networks at once however narrow the layer is.
+			 */
+			void groupSums(const double *weights, int numInputs, int numNeurons, const double *inputs, double *outputs, double bias)
+			{
+				Pack biasInput = broadcast(bias);
+
+				for (int j = 0; j < numNeurons; ++j)
+				{
+					const double *row = weights + j * (numInputs + 1) * groupSize;
+					const double *biasWeights = row + numInputs * groupSize;
+					Pack sum0 = mul(load(biasWeights), biasInput);
+					Pack sum1 = mul(load(biasWeights + packSize), biasInput);
+					Pack sum2 = mul(load(biasWeights + 2 * packSize), biasInput);
+					Pack sum3 = mul(load(biasWeights + 3 * packSize), biasInput);
+
+					for (int k = 0; k < numInputs; ++k)
+					{
+						const double *weight = row + k * groupSize;
+						const double *in = inputs + k * groupSize;
+
+						sum0 = add(sum0, mul(load(weight), load(in)));
+						sum1 = add(sum1, mul(load(weight + packSize), load(in + packSize)));
+						sum2 = add(sum2, mul(load(weight + 2 * packSize), load(in + 2 * packSize)));
+						sum3 = add(sum3, mul(load(weight + 3 * packSize), load(in + 3 * packSize)));
+					}
+
+					double *out = outputs + j * groupSize;
+
+					store(out, sum0);
+					store(out + packSize, sum1);
+					store(out + 2 * packSize, sum2);
+					store(out + 3 * packSize, sum3);
+				}
+			}
+
+			/**
+			 * @brief	Applies the activation function to the net inputs of a layer.
+			 */
+			template<Activation function>
+			void activateAll(double *values, int count, double response)
+			{
+				for (int i = 0; i < count; ++i)
+				{
+					values[i] = activate<function>(values[i], response);
+				}
+			}
+
+			void activateAll(Activation function, MathAccuracy accuracy, double *values, int count, double response)
+			{
+				switch (function)
+				{
+				case Activation::Tanh:
+					fastmath::tanh(accuracy, values, values, count);
+					break;
+				case Activation::ReLU:
+					activateAll<Activation::ReLU>(values, count, response);
+					break;
+				case Activation::Linear:
+					activateAll<Activation::Linear>(values, count, response);
+					break;
+				default:
+					fastmath::sigmoid(accuracy, values, values, count, response);
+					break;
+				}
+			}
+		}
+
+		PopulationEvaluator::PopulationEvaluator(const Topology &topology, const std::vector<std::vector<double> > &inputs, Params p)
+			: topology(topology),
+			bias(p.bias),
+			response(p.activationResponse),
+			numSamples(inputs.size()),
+			numBlocks((inputs.size() + blockSize - 1) / blockSize),
+			numOutputs(topology.layerSizes.empty() ? 0 : topology.layerSizes.back()),
+			numWeights(topology.getNumberOfWeights())
+		{
+			int width = topology.numInputs;
+
+			for (int i = 0; i < topology.layerSizes.size(); ++i)
+			{
+				width = std::max(width, topology.layerSizes[i]);
+			}
+
+			layerA.resize(width * std::max(blockSize, groupSize));
+			layerB.resize(width * std::max(blockSize, groupSize));
+
+			//Transpose the inputs; the padding of the last block stays zero
+			inputBlocks.assign(numBlocks * topology.numInputs * blockSize, 0);
+
+			for (int s = 0; s < numSamples; ++s)
+			{
+				if (inputs[s].size() != topology.numInputs)
+				{
+					continue;
+				}
+
+				double *block = &inputBlocks[(s / blockSize) * topology.numInputs * blockSize];
+
+				for (int k = 0; k < topology.numInputs; ++k)
+				{
+					block[k * blockSize + s % blockSize] = inputs[s][k];
+				}
+			}
+		}
+
+		void PopulationEvaluator::evaluate(const double *weights, int numGenomes, int stride, double *outputs)
+		{
+			if (numOutputs == 0)
+			{
+				return;
+			}
+
+			//Block by block, so the inputs stay in cache while the genomes stream through
+			for (int b = 0; b < numBlocks; ++b)
+			{
+				for (int g = 0; g < numGenomes; ++g)
+				{
+					forwardBlock(weights + (size_t)g * stride, b, outputs + (size_t)g * numSamples * numOutputs);
+				}
+			}
+		}
+
+		void PopulationEvaluator::evaluate(const std::vector<Genome> &population, std::vector<double> &outputs)
+		{
+			outputs.assign(population.size() * numSamples * numOutputs, 0);
+
+			if (numOutputs == 0)
+			{
+				return;
+			}
+
+			for (int b = 0; b < numBlocks; ++b)
+			{
+				for (int g = 0; g < population.size(); ++g)
+				{
+					if (population[g].weights.size() == numWeights)
+					{
+						forwardBlock(population[g].weights.data(), b, &outputs[(size_t)g * numSamples * numOutputs]);
+					}
+				}
+			}
+		}
+
+		void PopulationEvaluator::interleave(const std::vector<Genome> &population, std::vector<double> &block) const
+		{
+			int numGroups = (population.size() + groupSize - 1) / groupSize;
+
+			const double *lanes[groupSize];
+
+			block.assign((size_t)numGroups * numWeights * groupSize, 0);
+
+			for (int i = 0; i < numGroups; ++i)
+			{
+				double *group = &block[(size_t)i * numWeights * groupSize];
+				int count = 0;
+
+				for (int g = i * groupSize; g < population.size() && g < (i + 1) * groupSize; ++g)
+				{
+					lanes[g % groupSize] = population[g].weights.size() == numWeights ? population[g].weights.data() : nullptr;
+					count++;
+				}
+
+				//Write the group in order, reading the genomes of its lanes side by side
+				for (int w = 0; w < numWeights; ++w)
+				{
+					for (int lane = 0; lane < count; ++lane)
+					{
+						if (lanes[lane] != nullptr)
+						{
+							group[w * groupSize + lane] = lanes[lane][w];
+						}
+					}
+				}
+			}
+		}
+
+		void PopulationEvaluator::evaluateInterleaved(const double *block, int numGenomes, double *outputs)
+		{
+			if (numOutputs == 0)
+			{
+				return;
+			}
+
+			for (int g = 0; g < numGenomes; g += groupSize)
+			{
+				const double *group = block + (size_t)(g / groupSize) * numWeights * groupSize;
+
+				for (int s = 0; s < numSamples; ++s)
+				{
+					forwardGroup(group, s, std::min(groupSize, numGenomes - g), outputs + (size_t)g * numSamples * numOutputs);
+				}
+			}
+		}
+
+		void PopulationEvaluator::evaluateInterleaved(const std::vector<Genome> &population, std::vector<double> &outputs)
+		{
+			outputs.assign(population.size() * numSamples * numOutputs, 0);
+			interleave(population, interleaved);
+			evaluateInterleaved(interleaved.data(), population.size(), outputs.data());
+
+			//Genomes of the wrong size ran as zero weights in their lanes; clear them like evaluate() does
+			for (int g = 0; g < population.size(); ++g)
+			{
+				if (population[g].weights.size() != numWeights)
+				{
+					std::fill(outputs.begin() + (size_t)g * numSamples * numOutputs, outputs.begin() + (size_t)(g + 1) * numSamples * numOutputs, 0.0);
+				}
+			}
+		}
+
+		int PopulationEvaluator::getGroupSize()
+		{
+			return groupSize;
+		}
+
+		int PopulationEvaluator::getNumberOfSamples() const
+		{
+			return numSamples;
+		}
+
+		int PopulationEvaluator::getNumberOfOutputs() const
+		{
+			return numOutputs;
+		}
+
+		void PopulationEvaluator::forwardBlock(const double *weights, int block, double *outputs)
+		{
+			const double *in = &inputBlocks[block * topology.numInputs * blockSize];
+			double *out = layerA.data();
+			int numLayers = topology.layerSizes.size();
+
+			for (int l = 0; l < numLayers; ++l)
+			{
+				int numInputs = topology.getLayerInputs(l);
+
+				blockSums(weights, numInputs, topology.layerSizes[l], in, out, bias);
+				activateAll(topology.activations[l], topology.accuracy, out, topology.layerSizes[l] * blockSize, response);
+
+				weights += topology.layerSizes[l] * (numInputs + 1);
+				in = out;
+				out = out == layerA.data() ? layerB.data() : layerA.data();
+			}
+
+			//Transpose the last layer back, skipping the padding
+			int count = std::min(blockSize, numSamples - block * blockSize);
+
+			for (int s = 0; s < count; ++s)
+			{
+				double *sample = outputs + (block * blockSize + s) * numOutputs;
+
+				for (int j = 0; j < numOutputs; ++j)
+				{
+					sample[j] = in[j * blockSize + s];
+				}
+			}
+		}
+
+		void PopulationEvaluator::forwardGroup(const double *weights, int sample, int count, double *outputs)
+		{
+			//The same input goes to every lane
+			const double *input = &inputBlocks[(sample / blockSize) * topology.numInputs * blockSize + sample % blockSize];
+			double *in = layerB.data();
+			double *out = layerA.data();
+			int numLayers = topology.layerSizes.size();
+
+			for (int k = 0; k < topology.numInputs; ++k)
+			{
+				std::fill(in + k * groupSize, in + (k + 1) * groupSize, input[k * blockSize]);
+			}
+
+			for (int l = 0; l < numLayers; ++l)
+			{
+				int numInputs = topology.getLayerInputs(l);
+
+				groupSums(weights, numInputs, topology.layerSizes[l], in, out, bias);
+				activateAll(topology.activations[l], topology.accuracy, out, topology.layerSizes[l] * groupSize, response);
+
+				weights += topology.layerSizes[l] * (numInputs + 1) * groupSize;
+				std::swap(in, out);
+			}
+
+			//Scatter the lanes back to their genomes, skipping the padding
+			for (int g = 0; g < count; ++g)
+			{
+				double *genome = outputs + ((size_t)g * numSamples + sample) * numOutputs;
+
+				for (int j = 0; j < numOutputs; ++j)
+				{
+					genome[j] = in[j * groupSize + g];
+				}
+			}
+		}
+	}
+}
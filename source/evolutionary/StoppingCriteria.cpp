@@ -0,0 +1,29 @@
+/**
+ * @file	evolutionary\StoppingCriteria.cpp.
+ *
+ * @brief	Implements the stopping criteria of GeneticAlgorithm::run().
+ */
+#include "../../include/evolutionary/StoppingCriteria.hpp"
+
+namespace etunn
+{
+	namespace evolutionary
+	{
+		const char* stopReasonName(StopReason reason)
+		{
+			switch (reason)
+			{
+			case StopReason::TargetReached:
+				return "target";
+			case StopReason::Stagnation:
+				return "stagnation";
+			case StopReason::DiversityCollapse:
+				return "diversity";
+			case StopReason::TimeBudget:
+				return "time";
+			default:
+				return "generations";
+			}
+		}
+	}
+}
@@ -4,6 +4,8 @@
  * @brief	Implements the feedforward neural net class.
  */
 #include "../../include/feedforward/NeuralNet.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace etunn
 {
@@ -19,31 +21,45 @@ namespace etunn
 			numInputs = p.numInputs;
 			numOutputs = p.numOutputs;
 			numHiddenLayers = p.numHidden;
-			neuronsPerHiddenLyr = p.neuronsPerHiddenLayer;
+			hiddenLayerSizes = p.hiddenLayerSizes;
+			layerActivations = p.layerActivations;
+			accuracy = p.mathAccuracy;
+
+			//Fall back to equally sized sigmoid layers if the sizes were not set via setParams
+			hiddenLayerSizes.resize(numHiddenLayers, p.neuronsPerHiddenLayer);
+			layerActivations.resize(numHiddenLayers + 1, Activation::Sigmoid);
 		}
 
 		void NeuralNet::createNet()
 		{
-			//Create the layers of the network
-			if (numHiddenLayers > 0)
+			int inputs = numInputs;
+
+			//Create the hidden layers, each one fed by the previous one
+			for (int i = 0; i < numHiddenLayers; ++i)
 			{
-				//Create first hidden layer
-				layers.push_back(NeuronLayer(neuronsPerHiddenLyr, numInputs));
+				layers.push_back(NeuronLayer(hiddenLayerSizes[i], inputs, layerActivations[i], accuracy));
+				inputs = hiddenLayerSizes[i];
+			}
 
-				//Create the other layers
-				for (int i = 0; i < numHiddenLayers - 1; ++i)
-				{
-					layers.push_back(NeuronLayer(neuronsPerHiddenLyr, neuronsPerHiddenLyr));
-				}
+			//Create output layer
+			layers.push_back(NeuronLayer(numOutputs, inputs, layerActivations[numHiddenLayers], accuracy));
 
-				//Create output layer
-				layers.push_back(NeuronLayer(numOutputs, neuronsPerHiddenLyr));
-			}
-			else
+			//Nothing accumulated for training yet
+			int weights = 0;
+			layerOffsets.clear();
+
+			for (int i = 0; i < numHiddenLayers + 1; ++i)
 			{
-				//Create output layer
-				layers.push_back(NeuronLayer(numOutputs, numInputs));
+				layerOffsets.push_back(weights);
+				weights += layers[i].numNeurons * (layers[i].numInputsPerNeuron + 1);
 			}
+
+			gradients.assign(weights, 0.0);
+			numAccumulated = 0;
+
+#ifdef ETUNN_INSTRUMENTATION
+			inferenceStats = InferenceStats(numHiddenLayers + 1);
+#endif
 		}
 
 		std::vector<double> NeuralNet::getWeights() const
@@ -87,6 +103,18 @@ namespace etunn
 			}
 		}
 
+		Topology NeuralNet::getTopology() const
+		{
+			Topology topology;
+			topology.numInputs = numInputs;
+			topology.layerSizes = hiddenLayerSizes;
+			topology.layerSizes.push_back(numOutputs);
+			topology.activations = layerActivations;
+			topology.accuracy = accuracy;
+
+			return topology;
+		}
+
 		int NeuralNet::getNumberOfWeights() const
 		{
 			int weights = 0;
@@ -106,67 +134,217 @@ namespace etunn
 			return weights;
 		}
 
-		std::vector<double> NeuralNet::update(std::vector<double> &inputs, Params p)
+		std::vector<double> NeuralNet::update(const std::vector<double> &inputs, Params p) const
 		{
-			//Stores the resultant outputs from each layer
-			std::vector<double> outputs;
+			//Check that the amount of inputs is correct
+			if (inputs.size() != numInputs)
+			{
+				//Return an empty vector if incorrect.
+				return std::vector<double>();
+			}
 
-			int weight = 0;
+			return update(inputs.data(), p);
+		}
+
+		std::vector<double> NeuralNet::update(const double *inputs, Params p) const
+		{
+			//Every thread reuses its own scratch space
+			static thread_local Workspace workspace;
+
+			std::vector<double> outputs(numOutputs);
+			update(inputs, outputs.data(), workspace, p);
+
+			return outputs;
+		}
+
+		Workspace NeuralNet::createWorkspace() const
+		{
+			int largestLayer = 0;
+
+			for (int i = 0; i < numHiddenLayers; ++i)
+			{
+				largestLayer = std::max(largestLayer, hiddenLayerSizes[i]);
+			}
+
+			Workspace workspace;
+			workspace.layerA.reserve(largestLayer);
+			workspace.layerB.reserve(largestLayer);
 
+			return workspace;
+		}
+
+		std::vector<double> NeuralNet::forward(const std::vector<double> &inputs, Params p)
+		{
 			//Check that the amount of inputs is correct
 			if (inputs.size() != numInputs)
 			{
 				//Return an empty vector if incorrect.
-				return outputs;
+				return std::vector<double>();
 			}
 
+			forwardPass(inputs.data(), p);
+
+			return activations.back();
+		}
+
+		void NeuralNet::forwardPass(const double *inputs, Params p)
+		{
+			activations.resize(numHiddenLayers + 2);
+			activations[0].assign(inputs, inputs + numInputs);
+
 			//Layers
 			for (int i = 0; i < numHiddenLayers + 1; ++i)
 			{
+				activations[i + 1].resize(layers[i].numNeurons);
+				kernels::forwardLayer(layers[i], activations[i].data(), activations[i + 1].data(), p.bias, p.activationResponse);
+			}
+		}
+
+		void NeuralNet::backprop(std::vector<double> outputs, std::vector<double> desiredOutputs)
+		{
+			//Needs a forward() pass and one desired output per output
+			if (activations.size() != numHiddenLayers + 2 || outputs.size() != numOutputs
+				|| desiredOutputs.size() != numOutputs)
+			{
+				return;
+			}
+
+			backpropagate(outputs.data(), desiredOutputs.data());
+		}
+
+		void NeuralNet::backpropagate(const double *outputs, const double *desiredOutputs)
+		{
+			//Error terms of the output layer: d(error)/d(activation)
+			deltas.resize(numOutputs);
+
+			for (int j = 0; j < numOutputs; ++j)
+			{
+				deltas[j] = (outputs[j] - desiredOutputs[j])
+					* activationDerivative(layers[numHiddenLayers].activation, outputs[j], Params::activationResponse);
+			}
+
+			//Layers, from the output back to the first hidden layer
+			for (int i = numHiddenLayers; i >= 0; --i)
+			{
+				const std::vector<double> &inputs = activations[i];
+				int numLayerInputs = layers[i].numInputsPerNeuron;
+				double *layerGradients = gradients.data() + layerOffsets[i];
+
+				//The error terms of the layer below are only needed above the inputs
 				if (i > 0)
 				{
-					inputs = outputs;
+					previousDeltas.assign(numLayerInputs, 0.0);
 				}
 
-				outputs.clear();
-
-				weight = 0;
-
-				//Sum the (inputs * corresponding weights) for each neuron
-				//Run the total at through sigmoid function to get the output
 				for (int j = 0; j < layers[i].numNeurons; ++j)
 				{
-					double netinput = 0;
+					const double *weights = layers[i].neurons[j].weights.data();
+					double *neuronGradients = layerGradients + j * (numLayerInputs + 1);
+					double delta = deltas[j];
+
+					for (int k = 0; k < numLayerInputs; ++k)
+					{
+						neuronGradients[k] += delta * inputs[k];
+					}
 
-					int	NumInputs = layers[i].neurons[j].numInputs;
+					neuronGradients[numLayerInputs] += delta * Params::bias;
 
-					//Weights
-					for (int k = 0; k < layers[i].neurons[j].weights.size() - 1; ++k)
+					if (i > 0)
 					{
-						//Sum the weights * inputs
-						netinput += layers[i].neurons[j].weights[k] *
-							inputs[weight++];
+						for (int k = 0; k < numLayerInputs; ++k)
+						{
+							previousDeltas[k] += delta * weights[k];
+						}
 					}
+				}
+
+				if (i > 0)
+				{
+					for (int k = 0; k < numLayerInputs; ++k)
+					{
+						previousDeltas[k] *= activationDerivative(layers[i - 1].activation, inputs[k], Params::activationResponse);
+					}
+
+					deltas.swap(previousDeltas);
+				}
+			}
+
+			numAccumulated++;
+		}
+
+		void NeuralNet::applyGradients(Optimizer &optimizer)
+		{
+			if (numAccumulated == 0)
+			{
+				return;
+			}
+
+			//Average over the samples
+			double scale = 1.0 / numAccumulated;
+
+			for (int k = 0; k < gradients.size(); ++k)
+			{
+				gradients[k] *= scale;
+			}
 
-					//Add in the bias
-					netinput += layers[i].neurons[j].weights[NumInputs - 1] *
-						p.bias;
+			optimizer.nextStep();
 
-					//Store the outputs from each layer as they get generated
-					//The combined activation is first filtered through the sigmoid  function
-					outputs.push_back(sigmoid(netinput,
-						p.activationResponse));
+			//Every neuron keeps its own weights, so each one is a contiguous range of the gradients
+			int weight = 0;
 
-					weight = 0;
+			for (int i = 0; i < numHiddenLayers + 1; ++i)
+			{
+				for (int j = 0; j < layers[i].numNeurons; ++j)
+				{
+					Neuron &neuron = layers[i].neurons[j];
+					optimizer.apply(neuron.weights.data(), gradients.data() + weight, weight, neuron.numInputs);
+					weight += neuron.numInputs;
 				}
 			}
 
-			return outputs;
+			std::fill(gradients.begin(), gradients.end(), 0.0);
+			numAccumulated = 0;
+		}
+
+		double NeuralNet::train(const Batch &batch, Optimizer &optimizer, Params p)
+		{
+			if (batch.numInputs != numInputs || batch.numTargets != numOutputs || batch.numRows == 0)
+			{
+				return -1;
+			}
+
+			double error = 0;
+
+			for (int row = 0; row < batch.numRows; ++row)
+			{
+				forwardPass(batch.getInputs(row), p);
+
+				const double *targets = batch.getTargets(row);
+				const std::vector<double> &outputs = activations.back();
+
+				for (int j = 0; j < numOutputs; ++j)
+				{
+					error += (outputs[j] - targets[j]) * (outputs[j] - targets[j]);
+				}
+
+				backpropagate(outputs.data(), targets);
+			}
+
+			applyGradients(optimizer);
+
+			return error / ((double)batch.numRows * numOutputs);
+		}
+
+#ifdef ETUNN_INSTRUMENTATION
+		const InferenceStats& NeuralNet::getInferenceStats() const
+		{
+			return inferenceStats;
 		}
 
-		inline double NeuralNet::sigmoid(double activation, double response)
+		void NeuralNet::resetInferenceStats()
 		{
-			return (1 / (1 + exp(-activation / response)));
+			inferenceStats.reset();
 		}
+#endif
 	}
 }
\ No newline at end of file
@@ -0,0 +1,320 @@
+/**
+ * @file	lstm\NeuralNet.cpp.
+ *
+ * @brief	Implements the LSTM neural net class.
+ */
+#include "../../include/lstm/NeuralNet.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace etunn
+{
+	namespace lstm
+	{
+		namespace
+		{
+			double logistic(double x)
+			{
+				return 1 / (1 + std::exp(-x));
+			}
+		}
+
+		NeuralNet::NeuralNet() : stateSize(0)
+		{
+			//Do nothing
+		}
+
+		NeuralNet::NeuralNet(Params p) : stateSize(0)
+		{
+			numInputs = p.numInputs;
+			numOutputs = p.numOutputs;
+			numHiddenLayers = p.numHidden;
+			hiddenLayerSizes = p.hiddenLayerSizes;
+
+			//Fall back to equally sized layers if the sizes were not set via setParams
+			hiddenLayerSizes.resize(numHiddenLayers, p.neuronsPerHiddenLayer);
+			outputActivation = numHiddenLayers < p.layerActivations.size() ?
+				p.layerActivations[numHiddenLayers] : Activation::Sigmoid;
+		}
+
+		void NeuralNet::createNet()
+		{
+			int inputs = numInputs;
+			int offset = 0;
+
+			layerOffsets.clear();
+			stateOffsets.clear();
+			stateSize = 0;
+
+			//Each LSTM layer has four gates per neuron, each fed by the inputs, the previous hidden state and the bias
+			for (int i = 0; i < numHiddenLayers; ++i)
+			{
+				layerOffsets.push_back(offset);
+				offset += 4 * hiddenLayerSizes[i] * (inputs + hiddenLayerSizes[i] + 1);
+
+				stateOffsets.push_back(stateSize);
+				stateSize += hiddenLayerSizes[i];
+				inputs = hiddenLayerSizes[i];
+			}
+
+			//Output layer
+			layerOffsets.push_back(offset);
+			offset += numOutputs * (inputs + 1);
+
+			weights.clear();
+
+			for (int i = 0; i < offset; ++i)
+			{
+				//Set up the weights with an initial random value
+				float rand1 = (rand()) / (RAND_MAX + 1.0);
+				float rand2 = (rand()) / (RAND_MAX + 1.0);
+
+				weights.push_back(rand1 - rand2);
+			}
+
+			state = createState();
+		}
+
+		std::vector<double> NeuralNet::getWeights() const
+		{
+			return weights;
+		}
+
+		int NeuralNet::getNumberOfWeights() const
+		{
+			return weights.size();
+		}
+
+		void NeuralNet::putWeights(std::vector<double> &weights)
+		{
+			if (weights.size() == this->weights.size())
+			{
+				this->weights = weights;
+			}
+		}
+
+		void NeuralNet::reset()
+		{
+			state.reset();
+		}
+
+		std::vector<double> NeuralNet::update(std::vector<double> &inputs, Params p)
+		{
+			//Check that the amount of inputs is correct
+			if (inputs.size() != numInputs)
+			{
+				//Return an empty vector if incorrect.
+				return std::vector<double>();
+			}
+
+			std::vector<double> outputs(numOutputs);
+			forward(inputs.data(), 1, state, outputs.data(), p);
+
+			return outputs;
+		}
+
+		std::vector<std::vector<double> > NeuralNet::processSequence(const std::vector<std::vector<double> > &sequence, Params p)
+		{
+			int length = sequence.size();
+
+			//Store the time steps row after row
+			std::vector<double> inputs(length * numInputs);
+
+			for (int t = 0; t < length; ++t)
+			{
+				if (sequence[t].size() != numInputs)
+				{
+					return std::vector<std::vector<double> >();
+				}
+
+				std::copy(sequence[t].begin(), sequence[t].end(), inputs.begin() + t * numInputs);
+			}
+
+			std::vector<double> outputs(length * numOutputs);
+			forward(inputs.data(), length, state, outputs.data(), p);
+
+			std::vector<std::vector<double> > result(length);
+
+			for (int t = 0; t < length; ++t)
+			{
+				result[t].assign(outputs.begin() + t * numOutputs, outputs.begin() + (t + 1) * numOutputs);
+			}
+
+			return result;
+		}
+
+		State NeuralNet::createState() const
+		{
+			int largestLayer = 0;
+
+			for (int i = 0; i < numHiddenLayers; ++i)
+			{
+				largestLayer = std::max(largestLayer, hiddenLayerSizes[i]);
+			}
+
+			State newState;
+			newState.hidden.assign(stateSize, 0);
+			newState.cell.assign(stateSize, 0);
+			newState.sequenceA.reserve(largestLayer);
+			newState.sequenceB.reserve(largestLayer);
+			newState.gates.reserve(4 * largestLayer);
+
+			return newState;
+		}
+
+		void NeuralNet::step(const double *inputs, State &state, double *outputs, Params p) const
+		{
+			forward(inputs, 1, state, outputs, p);
+		}
+
+		void NeuralNet::processSequence(const double *inputs, int length, State &state, double *outputs, Params p) const
+		{
+			forward(inputs, length, state, outputs, p);
+		}
+
+		void NeuralNet::forward(const double *inputs, int length, State &state, double *outputs, Params p) const
+		{
+			int layerInputs = numInputs;
+
+			//A state of another net starts over
+			if (state.hidden.size() != stateSize)
+			{
+				state.hidden.assign(stateSize, 0);
+				state.cell.assign(stateSize, 0);
+			}
+
+			//LSTM layers, each one over the whole sequence
+			for (int i = 0; i < numHiddenLayers; ++i)
+			{
+				std::vector<double> &buffer = i % 2 ? state.sequenceB : state.sequenceA;
+				buffer.resize(length * hiddenLayerSizes[i]);
+
+				forwardLayer(i, inputs, length, state, buffer.data(), p);
+
+				inputs = buffer.data();
+				layerInputs = hiddenLayerSizes[i];
+			}
+
+			//Output layer
+			const double *layerWeights = &weights[layerOffsets[numHiddenLayers]];
+
+			for (int t = 0; t < length; ++t)
+			{
+				const double *x = inputs + t * layerInputs;
+
+				for (int j = 0; j < numOutputs; ++j)
+				{
+					const double *row = layerWeights + j * (layerInputs + 1);
+					double netinput = 0;
+
+					for (int k = 0; k < layerInputs; ++k)
+					{
+						netinput += row[k] * x[k];
+					}
+
+					netinput += row[layerInputs] * p.bias;
+
+					outputs[t * numOutputs + j] = activate(outputActivation, netinput, p.activationResponse);
+				}
+			}
+		}
+
+		void NeuralNet::forwardLayer(int layer, const double *inputs, int length, State &state, double *outputs, Params p) const
+		{
+			int layerInputs = layer == 0 ? numInputs : hiddenLayerSizes[layer - 1];
+			int size = hiddenLayerSizes[layer];
+			int rowLength = layerInputs + size + 1;
+			int numGates = 4 * size;
+
+			const double *layerWeights = &weights[layerOffsets[layer]];
+			double *h = &state.hidden[stateOffsets[layer]];
+			double *c = &state.cell[stateOffsets[layer]];
+			std::vector<double> &gates = state.gates;
+
+			gates.resize(length * numGates);
+
+			//Input and bias part of every gate for the whole sequence, one weight row at a time
+			//Four time steps share each loaded weight and give four independent sums
+			for (int r = 0; r < numGates; ++r)
+			{
+				const double *row = layerWeights + r * rowLength;
+				double biasInput = row[layerInputs + size] * p.bias;
+				int t = 0;
+
+				for (; t + 4 <= length; t += 4)
+				{
+					const double *x0 = inputs + t * layerInputs, *x1 = x0 + layerInputs;
+					const double *x2 = x1 + layerInputs, *x3 = x2 + layerInputs;
+					double sum0 = biasInput, sum1 = biasInput, sum2 = biasInput, sum3 = biasInput;
+
+					for (int k = 0; k < layerInputs; ++k)
+					{
+						sum0 += row[k] * x0[k];
+						sum1 += row[k] * x1[k];
+						sum2 += row[k] * x2[k];
+						sum3 += row[k] * x3[k];
+					}
+
+					gates[t * numGates + r] = sum0;
+					gates[(t + 1) * numGates + r] = sum1;
+					gates[(t + 2) * numGates + r] = sum2;
+					gates[(t + 3) * numGates + r] = sum3;
+				}
+
+				for (; t < length; ++t)
+				{
+					const double *x = inputs + t * layerInputs;
+					double netinput = biasInput;
+
+					for (int k = 0; k < layerInputs; ++k)
+					{
+						netinput += row[k] * x[k];
+					}
+
+					gates[t * numGates + r] = netinput;
+				}
+			}
+
+			//Recurrent part, step by step, four weight rows at a time
+			for (int t = 0; t < length; ++t)
+			{
+				double *g = &gates[t * numGates];
+
+				//numGates is a multiple of four
+				for (int r = 0; r < numGates; r += 4)
+				{
+					const double *row0 = layerWeights + r * rowLength + layerInputs, *row1 = row0 + rowLength;
+					const double *row2 = row1 + rowLength, *row3 = row2 + rowLength;
+					double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+
+					for (int k = 0; k < size; ++k)
+					{
+						sum0 += row0[k] * h[k];
+						sum1 += row1[k] * h[k];
+						sum2 += row2[k] * h[k];
+						sum3 += row3[k] * h[k];
+					}
+
+					g[r] += sum0;
+					g[r + 1] += sum1;
+					g[r + 2] += sum2;
+					g[r + 3] += sum3;
+				}
+
+				for (int j = 0; j < size; ++j)
+				{
+					double inputGate = logistic(g[j]);
+					double forgetGate = logistic(g[size + j]);
+					double candidate = std::tanh(g[2 * size + j]);
+					double outputGate = logistic(g[3 * size + j]);
+
+					c[j] = forgetGate * c[j] + inputGate * candidate;
+					h[j] = outputGate * std::tanh(c[j]);
+
+					outputs[t * size + j] = h[j];
+				}
+			}
+		}
+	}
+}
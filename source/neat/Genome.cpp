@@ -0,0 +1,337 @@
+/**
+ * @file	neat\Genome.cpp.
+ *
+ * @brief	Implements the topology-evolving genome class.
+ */
+#include "../../include/neat/Genome.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace etunn
+{
+	namespace neat
+	{
+		namespace
+		{
+			//Weights of the compatibility distance
+			const double excessCoefficient = 1.0;
+			const double disjointCoefficient = 1.0;
+			const double weightCoefficient = 0.4;
+
+			//How often a structural mutation tries to find a suitable spot
+			const int numTries = 20;
+
+			double randFloat()
+			{
+				return (rand()) / (RAND_MAX + 1.0);
+			}
+
+			double randomWeight()
+			{
+				return randFloat() - randFloat();
+			}
+		}
+
+		Genome::Genome() : fitness(0)
+		{
+		}
+
+		Genome::Genome(int numInputs, int numOutputs, InnovationTracker &tracker) : fitness(0)
+		{
+			//Inputs, then the bias, then the outputs
+			for (int i = 0; i < numInputs; ++i)
+			{
+				nodes.push_back(NodeGene(i, NodeType::Input));
+			}
+
+			nodes.push_back(NodeGene(numInputs, NodeType::Bias));
+
+			for (int i = 0; i < numOutputs; ++i)
+			{
+				nodes.push_back(NodeGene(numInputs + 1 + i, NodeType::Output));
+			}
+
+			//Connect every input and the bias to every output
+			for (int i = 0; i < numInputs + 1; ++i)
+			{
+				for (int j = 0; j < numOutputs; ++j)
+				{
+					int to = numInputs + 1 + j;
+					insertConnection(ConnectionGene(i, to, randomWeight(), true, tracker.getConnectionInnovation(i, to)));
+				}
+			}
+		}
+
+		void Genome::mutateWeights(double mutationRate, double maxPerturbation)
+		{
+			for (int i = 0; i < connections.size(); ++i)
+			{
+				if (randFloat() < mutationRate)
+				{
+					//Add or subtract a small value
+					connections[i].weight += randomWeight() * maxPerturbation;
+				}
+			}
+		}
+
+		bool Genome::addConnection(InnovationTracker &tracker)
+		{
+			for (int attempt = 0; attempt < numTries; ++attempt)
+			{
+				const NodeGene &from = nodes[rand() % nodes.size()];
+				const NodeGene &to = nodes[rand() % nodes.size()];
+
+				//Outputs never feed other nodes and inputs never get fed
+				if (from.type == NodeType::Output || to.type == NodeType::Input ||
+					to.type == NodeType::Bias || from.id == to.id)
+				{
+					continue;
+				}
+
+				bool exists = false;
+
+				for (int i = 0; i < connections.size(); ++i)
+				{
+					if (connections[i].from == from.id && connections[i].to == to.id)
+					{
+						exists = true;
+						break;
+					}
+				}
+
+				//Keep the network feedforward
+				if (exists || hasPath(to.id, from.id))
+				{
+					continue;
+				}
+
+				insertConnection(ConnectionGene(from.id, to.id, randomWeight(), true,
+					tracker.getConnectionInnovation(from.id, to.id)));
+
+				return true;
+			}
+
+			return false;
+		}
+
+		bool Genome::addNode(InnovationTracker &tracker)
+		{
+			if (connections.empty())
+			{
+				return false;
+			}
+
+			for (int attempt = 0; attempt < numTries; ++attempt)
+			{
+				int index = rand() % connections.size();
+
+				if (!connections[index].enabled)
+				{
+					continue;
+				}
+
+				ConnectionGene split = connections[index];
+				connections[index].enabled = false;
+
+				int node = tracker.getSplitNode(split.innovation);
+
+				//The same connection was split before in this genome (and re-enabled by crossover)
+				for (int i = 0; i < nodes.size(); ++i)
+				{
+					if (nodes[i].id == node)
+					{
+						node = tracker.createNode();
+						break;
+					}
+				}
+
+				insertNode(NodeGene(node, NodeType::Hidden));
+
+				//The incoming weight is 1 and the outgoing one keeps the old weight, so the behaviour barely changes
+				insertConnection(ConnectionGene(split.from, node, 1, true, tracker.getConnectionInnovation(split.from, node)));
+				insertConnection(ConnectionGene(node, split.to, split.weight, true, tracker.getConnectionInnovation(node, split.to)));
+
+				return true;
+			}
+
+			return false;
+		}
+
+		double Genome::compatibility(const Genome &other) const
+		{
+			int i = 0, j = 0;
+			int disjoint = 0, excess = 0, matching = 0;
+			double weightDifference = 0;
+
+			//Both lists are sorted by innovation number
+			while (i < connections.size() && j < other.connections.size())
+			{
+				if (connections[i].innovation == other.connections[j].innovation)
+				{
+					weightDifference += std::fabs(connections[i].weight - other.connections[j].weight);
+					++matching;
+					++i;
+					++j;
+				}
+				else if (connections[i].innovation < other.connections[j].innovation)
+				{
+					++disjoint;
+					++i;
+				}
+				else
+				{
+					++disjoint;
+					++j;
+				}
+			}
+
+			excess = (connections.size() - i) + (other.connections.size() - j);
+
+			double n = (double)std::max(connections.size(), other.connections.size());
+
+			if (n < 1)
+			{
+				n = 1;
+			}
+
+			double distance = excessCoefficient * excess / n + disjointCoefficient * disjoint / n;
+
+			if (matching > 0)
+			{
+				distance += weightCoefficient * weightDifference / matching;
+			}
+
+			return distance;
+		}
+
+		Genome Genome::crossover(const Genome &fitter, const Genome &other)
+		{
+			Genome baby;
+			baby.nodes = fitter.nodes;
+
+			int j = 0;
+
+			for (int i = 0; i < fitter.connections.size(); ++i)
+			{
+				ConnectionGene gene = fitter.connections[i];
+
+				while (j < other.connections.size() && other.connections[j].innovation < gene.innovation)
+				{
+					++j;
+				}
+
+				//Matching genes take their weight from either parent
+				if (j < other.connections.size() && other.connections[j].innovation == gene.innovation)
+				{
+					if (randFloat() < 0.5)
+					{
+						gene.weight = other.connections[j].weight;
+					}
+
+					//Genes disabled in either parent are likely to stay disabled
+					gene.enabled = true;
+
+					if (!fitter.connections[i].enabled || !other.connections[j].enabled)
+					{
+						gene.enabled = randFloat() >= 0.75;
+					}
+				}
+
+				//Disjoint and excess genes come from the fitter parent
+				baby.connections.push_back(gene);
+			}
+
+			return baby;
+		}
+
+		int Genome::getNumInputs() const
+		{
+			int inputs = 0;
+
+			for (int i = 0; i < nodes.size(); ++i)
+			{
+				if (nodes[i].type == NodeType::Input)
+				{
+					++inputs;
+				}
+			}
+
+			return inputs;
+		}
+
+		int Genome::getNumOutputs() const
+		{
+			int outputs = 0;
+
+			for (int i = 0; i < nodes.size(); ++i)
+			{
+				if (nodes[i].type == NodeType::Output)
+				{
+					++outputs;
+				}
+			}
+
+			return outputs;
+		}
+
+		bool Genome::hasPath(int from, int to) const
+		{
+			std::vector<int> stack(1, from);
+			std::vector<int> visited;
+
+			while (!stack.empty())
+			{
+				int node = stack.back();
+				stack.pop_back();
+
+				if (node == to)
+				{
+					return true;
+				}
+
+				if (std::find(visited.begin(), visited.end(), node) != visited.end())
+				{
+					continue;
+				}
+
+				visited.push_back(node);
+
+				//Disabled connections count as well, crossover may enable them again
+				for (int i = 0; i < connections.size(); ++i)
+				{
+					if (connections[i].from == node)
+					{
+						stack.push_back(connections[i].to);
+					}
+				}
+			}
+
+			return false;
+		}
+
+		void Genome::insertNode(const NodeGene &node)
+		{
+			std::vector<NodeGene>::iterator it = nodes.begin();
+
+			while (it != nodes.end() && it->id < node.id)
+			{
+				++it;
+			}
+
+			nodes.insert(it, node);
+		}
+
+		void Genome::insertConnection(const ConnectionGene &connection)
+		{
+			std::vector<ConnectionGene>::iterator it = connections.begin();
+
+			while (it != connections.end() && it->innovation < connection.innovation)
+			{
+				++it;
+			}
+
+			connections.insert(it, connection);
+		}
+	}
+}
@@ -0,0 +1,50 @@
+/**
+ * @file	neat\InnovationTracker.cpp.
+ *
+ * @brief	Implements the innovation tracker class.
+ */
+#include "../../include/neat/InnovationTracker.hpp"
+
+namespace etunn
+{
+	namespace neat
+	{
+		InnovationTracker::InnovationTracker(int numNodes)
+			: nextNode(numNodes),
+			nextInnovation(0)
+		{
+		}
+
+		int InnovationTracker::getConnectionInnovation(int from, int to)
+		{
+			std::pair<int, int> key(from, to);
+			std::map<std::pair<int, int>, int>::iterator it = connections.find(key);
+
+			if (it != connections.end())
+			{
+				return it->second;
+			}
+
+			connections[key] = nextInnovation;
+			return nextInnovation++;
+		}
+
+		int InnovationTracker::getSplitNode(int innovation)
+		{
+			std::map<int, int>::iterator it = splits.find(innovation);
+
+			if (it != splits.end())
+			{
+				return it->second;
+			}
+
+			splits[innovation] = nextNode;
+			return nextNode++;
+		}
+
+		int InnovationTracker::createNode()
+		{
+			return nextNode++;
+		}
+	}
+}
@@ -0,0 +1,262 @@
+/**
+ * @file	neat\NeatAlgorithm.cpp.
+ *
+ * @brief	Implements the topology-evolving genetic algorithm class.
+ */
+#include "../../include/neat/NeatAlgorithm.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace etunn
+{
+	namespace neat
+	{
+		namespace
+		{
+			//Species that did not improve for this many generations die out
+			const int maxStaleness = 15;
+
+			//Species with at least this many members keep their champion unchanged
+			const int championMinSize = 5;
+
+			//Share of each species that is allowed to reproduce
+			const double survivalRate = 0.5;
+
+			double randFloat()
+			{
+				return (rand()) / (RAND_MAX + 1.0);
+			}
+		}
+
+		NeatAlgorithm::NeatAlgorithm(int popSize, double mutRat, double crossRat, int numInputs, int numOutputs)
+			: innovations(numInputs + 1 + numOutputs),
+			popSize(popSize),
+			mutationRate(mutRat),
+			crossoverRate(crossRat),
+			bestFitness(0),
+			averageFitness(0),
+			fittestGenome(0),
+			generation(0)
+		{
+			//Initialise population with minimal genomes, all fitnesses set to zero
+			for (int i = 0; i < popSize; ++i)
+			{
+				population.push_back(Genome(numInputs, numOutputs, innovations));
+			}
+		}
+
+		std::vector<Genome> NeatAlgorithm::epoch(std::vector<Genome> &old_pop, Params p)
+		{
+			//Assign the given population to the classes population
+			population = old_pop;
+
+			calculateBestAv();
+			speciate(p.compatibilityThreshold);
+
+			//Update the staleness of each species and remove the ones that stopped improving
+			for (int s = species.size() - 1; s >= 0; --s)
+			{
+				Species &sp = species[s];
+				bool holdsBest = false;
+				double best = 0;
+
+				for (int i = 0; i < sp.members.size(); ++i)
+				{
+					best = std::max(best, population[sp.members[i]].fitness);
+					holdsBest = holdsBest || sp.members[i] == fittestGenome;
+				}
+
+				if (best > sp.bestFitness)
+				{
+					sp.bestFitness = best;
+					sp.staleness = 0;
+				}
+				else
+				{
+					++sp.staleness;
+				}
+
+				if (sp.staleness > maxStaleness && !holdsBest)
+				{
+					species.erase(species.begin() + s);
+				}
+			}
+
+			//Share the fitness within each species
+			std::vector<double> sharedFitness(species.size(), 0);
+			double totalShared = 0;
+
+			for (int s = 0; s < species.size(); ++s)
+			{
+				for (int i = 0; i < species[s].members.size(); ++i)
+				{
+					sharedFitness[s] += population[species[s].members[i]].fitness / species[s].members.size();
+				}
+
+				totalShared += sharedFitness[s];
+			}
+
+			//Each species gets a number of offspring proportional to its shared fitness
+			std::vector<int> numOffspring(species.size(), 0);
+			int assigned = 0;
+
+			for (int s = 0; s < species.size(); ++s)
+			{
+				double share = totalShared > 0 ? sharedFitness[s] / totalShared : 1.0 / species.size();
+				numOffspring[s] = (int)(share * popSize);
+				assigned += numOffspring[s];
+			}
+
+			//Hand out the rounding remainder
+			for (int s = 0; assigned < popSize && !species.empty(); s = (s + 1) % species.size())
+			{
+				++numOffspring[s];
+				++assigned;
+			}
+
+			//Create a temporary vector to store the new chromosomes
+			std::vector<Genome> newPopulation;
+
+			for (int s = 0; s < species.size(); ++s)
+			{
+				std::vector<int> &members = species[s].members;
+
+				//Fittest members first
+				std::sort(members.begin(), members.end(), [this](int a, int b)
+				{
+					return population[b] < population[a];
+				});
+
+				int produced = 0;
+
+				if (numOffspring[s] > 0 && members.size() >= championMinSize)
+				{
+					newPopulation.push_back(population[members[0]]);
+					newPopulation.back().fitness = 0;
+					++produced;
+				}
+
+				int numParents = std::max(1, (int)(members.size() * survivalRate));
+
+				for (; produced < numOffspring[s]; ++produced)
+				{
+					const Genome &mum = population[members[rand() % numParents]];
+					Genome baby;
+
+					if (numParents > 1 && randFloat() < crossoverRate)
+					{
+						const Genome &dad = population[members[rand() % numParents]];
+						baby = dad < mum ? Genome::crossover(mum, dad) : Genome::crossover(dad, mum);
+					}
+					else
+					{
+						baby = mum;
+					}
+
+					//Mutate
+					baby.mutateWeights(mutationRate, p.maxPerturbation);
+
+					if (randFloat() < p.addNodeRate)
+					{
+						baby.addNode(innovations);
+					}
+
+					if (randFloat() < p.addConnectionRate)
+					{
+						baby.addConnection(innovations);
+					}
+
+					baby.fitness = 0;
+					newPopulation.push_back(baby);
+				}
+
+				//A random member represents the species in the next generation
+				species[s].representative = population[members[rand() % members.size()]];
+			}
+
+			++generation;
+
+			population = newPopulation;
+			return population;
+		}
+
+		void NeatAlgorithm::speciate(double threshold)
+		{
+			for (int s = 0; s < species.size(); ++s)
+			{
+				species[s].members.clear();
+			}
+
+			for (int i = 0; i < population.size(); ++i)
+			{
+				bool found = false;
+
+				for (int s = 0; s < species.size(); ++s)
+				{
+					if (population[i].compatibility(species[s].representative) < threshold)
+					{
+						species[s].members.push_back(i);
+						found = true;
+						break;
+					}
+				}
+
+				if (!found)
+				{
+					species.push_back(Species(population[i]));
+					species.back().members.push_back(i);
+				}
+			}
+
+			//Remove species that have no members left
+			for (int s = species.size() - 1; s >= 0; --s)
+			{
+				if (species[s].members.empty())
+				{
+					species.erase(species.begin() + s);
+				}
+			}
+		}
+
+		void NeatAlgorithm::calculateBestAv()
+		{
+			double totalFitness = 0;
+			bestFitness = 0;
+			fittestGenome = 0;
+
+			for (int i = 0; i < population.size(); ++i)
+			{
+				//Update best if necessary
+				if (population[i].fitness > bestFitness)
+				{
+					bestFitness = population[i].fitness;
+					fittestGenome = i;
+				}
+
+				totalFitness += population[i].fitness;
+			}
+
+			averageFitness = population.empty() ? 0 : totalFitness / population.size();
+		}
+
+		std::vector<Genome> NeatAlgorithm::getChromos() const
+		{
+			return population;
+		}
+
+		double NeatAlgorithm::getAverageFitness() const
+		{
+			return averageFitness;
+		}
+
+		double NeatAlgorithm::getBestFitness() const
+		{
+			return bestFitness;
+		}
+
+		int NeatAlgorithm::getNumSpecies() const
+		{
+			return species.size();
+		}
+	}
+}
@@ -0,0 +1,187 @@
+/**
+ * @file	neat\Network.cpp.
+ *
+ * @brief	Implements the compiled network of a topology-evolving genome.
+ */
+#include "../../include/neat/Network.hpp"
+#include "../../include/Activation.hpp"
+#include <map>
+
+namespace etunn
+{
+	namespace neat
+	{
+		Network::Network(const Genome &genome) : numInputs(genome.getNumInputs())
+		{
+			const std::vector<NodeGene> &nodes = genome.nodes;
+			const std::vector<ConnectionGene> &connections = genome.connections;
+
+			std::map<int, int> index;
+
+			for (int i = 0; i < nodes.size(); ++i)
+			{
+				index[nodes[i].id] = i;
+			}
+
+			//Mark every node that can influence an output (walking the connections backwards)
+			std::vector<bool> relevant(nodes.size(), false);
+			std::vector<int> stack;
+
+			for (int i = 0; i < nodes.size(); ++i)
+			{
+				if (nodes[i].type == NodeType::Output)
+				{
+					relevant[i] = true;
+					stack.push_back(nodes[i].id);
+				}
+			}
+
+			while (!stack.empty())
+			{
+				int node = stack.back();
+				stack.pop_back();
+
+				for (int i = 0; i < connections.size(); ++i)
+				{
+					if (connections[i].enabled && connections[i].to == node && !relevant[index[connections[i].from]])
+					{
+						relevant[index[connections[i].from]] = true;
+						stack.push_back(connections[i].from);
+					}
+				}
+			}
+
+			//Count the incoming connections of each node to sort them topologically
+			std::vector<int> pending(nodes.size(), 0);
+
+			for (int i = 0; i < connections.size(); ++i)
+			{
+				if (connections[i].enabled && relevant[index[connections[i].to]])
+				{
+					++pending[index[connections[i].to]];
+				}
+			}
+
+			//Inputs and the bias are always available
+			std::vector<int> slot(nodes.size(), -1);
+			std::vector<int> ready;
+
+			for (int i = 0; i < nodes.size(); ++i)
+			{
+				if (nodes[i].type == NodeType::Input)
+				{
+					slot[i] = nodes[i].id;
+					ready.push_back(i);
+				}
+				else if (nodes[i].type == NodeType::Bias)
+				{
+					slot[i] = numInputs;
+					ready.push_back(i);
+				}
+				else if (relevant[i] && pending[i] == 0)
+				{
+					ready.push_back(i);
+				}
+			}
+
+			std::vector<int> order;
+
+			while (!ready.empty())
+			{
+				int node = ready.back();
+				ready.pop_back();
+
+				if (nodes[node].type == NodeType::Hidden || nodes[node].type == NodeType::Output)
+				{
+					slot[node] = numInputs + 1 + order.size();
+					order.push_back(node);
+				}
+
+				for (int i = 0; i < connections.size(); ++i)
+				{
+					if (connections[i].enabled && connections[i].from == nodes[node].id)
+					{
+						int target = index[connections[i].to];
+
+						if (relevant[target] && --pending[target] == 0)
+						{
+							ready.push_back(target);
+						}
+					}
+				}
+			}
+
+			//Store the incoming connections of each node in evaluation order
+			for (int k = 0; k < order.size(); ++k)
+			{
+				rowStart.push_back(sources.size());
+
+				for (int i = 0; i < connections.size(); ++i)
+				{
+					if (connections[i].enabled && connections[i].to == nodes[order[k]].id)
+					{
+						sources.push_back(slot[index[connections[i].from]]);
+						weights.push_back(connections[i].weight);
+					}
+				}
+			}
+
+			rowStart.push_back(sources.size());
+
+			for (int i = 0; i < nodes.size(); ++i)
+			{
+				if (nodes[i].type == NodeType::Output)
+				{
+					outputSlots.push_back(slot[i]);
+				}
+			}
+
+			values.resize(numInputs + 1 + order.size(), 0);
+		}
+
+		std::vector<double> Network::update(const std::vector<double> &inputs, Params p)
+		{
+			std::vector<double> outputs;
+
+			//Check that the amount of inputs is correct
+			if (inputs.size() != numInputs)
+			{
+				//Return an empty vector if incorrect.
+				return outputs;
+			}
+
+			for (int i = 0; i < numInputs; ++i)
+			{
+				values[i] = inputs[i];
+			}
+
+			values[numInputs] = p.bias;
+
+			//Nodes
+			for (int k = 0; k < rowStart.size() - 1; ++k)
+			{
+				double netinput = 0;
+
+				//Incoming connections
+				for (int i = rowStart[k]; i < rowStart[k + 1]; ++i)
+				{
+					netinput += weights[i] * values[sources[i]];
+				}
+
+				values[numInputs + 1 + k] = activate(Activation::Sigmoid, netinput, p.activationResponse);
+			}
+
+			for (int i = 0; i < outputSlots.size(); ++i)
+			{
+				outputs.push_back(values[outputSlots[i]]);
+			}
+
+			return outputs;
+		}
+
+		int Network::getNumberOfConnections() const
+		{
+			return weights.size();
+		}
+	}
+}